@@ -1,6 +1,7 @@
 #include "Application.h"
 
 #include "types/MethodMaster.h"
+#include "types/Scriptable.h"
 #include "WindowManager.h"
 #include "input/Keyboard.h"
 #include "Serializer.h"
@@ -10,7 +11,6 @@
 #include "Time.h"
 #include "graphics/PostProcess.h"
 #include "graphics/Renderer.h"
-#include "Memory.h"
 #include "input/Input.h"
 
 #include "Window.h"
@@ -20,6 +20,9 @@
 #include "core/platform/Platform.h"
 
 #include "game/SceneManager.h"
+#include "core/titanscript/ScriptScheduler.h"
+#include "core/titanscript/ScriptProfiler.h"
+#include "ThreadPool.h"
 #include "input/EventManager.h"
 
 #include "NodeManager.h"
@@ -71,7 +74,6 @@ void Application::InitEngine()
 	MessageHandler::init();
 	ContentManager::Init();
 	TypeManager::init();
-	GarbageCollector::init();
 	Input::init();
 	EventManager::init();
 	SceneManager::init();
@@ -108,6 +110,9 @@ void Application::FinishDraw()
 void Application::Loop()
 {
 	Time::Init();
+	ScriptScheduler::Init();
+	ThreadPool::Init();
+	ScriptProfiler::Init();
 	InitEngine();
 	InitRenderer();
 	init();
@@ -161,8 +166,6 @@ void Application::Loop()
 
 		if (timer.update())						//Print FPS each time after 1.0s
 		{
-			GC->clean();
-
 			//restart timer
 			timer.start();
 		}
@@ -174,8 +177,12 @@ void Application::Loop()
 		{
 			TIME->OnUpdate();
 			update();
+			Scriptable::flush_deferred_signals();
 			//PhysicsWorld2D::update();
 			INPUT->Clean();
+			EventManager::get_manager().clean();
+
+			ERROR_HANDLER->update();
 		}
 
 		if (default_target->should_update())
@@ -186,9 +193,6 @@ void Application::Loop()
 
 			window->SwapBuffer();					//Switch buffers			
 		}
-
-		GC->free();
-
 	}
 
 	//Quit
@@ -202,14 +206,13 @@ void Application::Quit()
 	CONTENT->FreeAll();
 	Primitives::Destroy();
 	//NodeManager::Free();
-	GC->free();
 	StringUtils::Free();
 	//PhysicsWorld2D::DestroyWorld();
 	FBOMANAGER->free();
 	ERROR_HANDLER->clean();
 	Audio::Free();
 	SCENEMANAGER->Free();
-	EventManager::get_manager().clean();
+	EventManager::free();
 	MethodMaster::clean();
 
 	WINDOWMAN->clean();
@@ -2,70 +2,41 @@
 
 #include <vector>
 #include <algorithm>
+#include <initializer_list>
 
-template<class VAL> class Array
+template<class VAL, class ALLOC = std::allocator<VAL>> class Array
 {
 private:
-	typedef std::vector<VAL> V;
+	typedef std::vector<VAL, ALLOC> V;
 	V vec;
 
 public:
 	Array() { }
+	Array(const Array &p_array) = default;
+	Array(Array &&p_array) = default;
+	Array(V &&p_vec) : vec(std::move(p_vec)) { }
+
+	//copies the values of an Array that uses another allocator
+	template<class OTHER>
+	Array(const Array<VAL, OTHER> &p_array) : vec(p_array.begin(), p_array.end()) { }
+
+	Array(std::initializer_list<VAL> p_values) : vec(p_values) { }
 	Array(const VAL &v_0)
 	{
 		push_back(v_0);
 	}
-	Array(const VAL &v_0, const VAL &v_1)
-		: Array(v_0)
-	{
-		push_back(v_1);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2)
-		: Array(v_0, v_1)
-	{
-		push_back(v_2);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3)
-		: Array(v_0, v_1, v_2)
-	{
-		push_back(v_3);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4)
-		: Array(v_0, v_1, v_2, v_3)
-	{
-		push_back(v_4);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5)
-		: Array(v_0, v_1, v_2, v_3, v_4)
-	{
-		push_back(v_5);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5, const VAL &v_6)
-		: Array(v_0, v_1, v_2, v_3, v_4, v_5)
-	{
-		push_back(v_6);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5, const VAL &v_6, const VAL &v_7)
-		: Array(v_0, v_1, v_2, v_3, v_4, v_5, v_6)
-	{
-		push_back(v_7);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5, const VAL &v_6, const VAL &v_7, const VAL &v_8)
-		: Array(v_0, v_1, v_2, v_3, v_4, v_5, v_6, v_7)
-	{
-		push_back(v_8);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5, const VAL &v_6, const VAL &v_7, const VAL &v_8, const VAL &v_9)
-		: Array(v_0, v_1, v_2, v_3, v_4, v_5, v_6, v_7, v_8)
-	{
-		push_back(v_9);
-	}
-	Array(const VAL &v_0, const VAL &v_1, const VAL &v_2, const VAL &v_3, const VAL &v_4, const VAL &v_5, const VAL &v_6, const VAL &v_7, const VAL &v_8, const VAL &v_9, const VAL &v_10)
-		: Array(v_0, v_1, v_2, v_3, v_4, v_5, v_6, v_7, v_8, v_9)
+
+	//Array(a, b, c) holds a, b and c
+	template<typename... ARGS>
+	Array(const VAL &v_0, const VAL &v_1, const ARGS&... v_rest)
 	{
-		push_back(v_10);
+		vec.reserve(2 + sizeof...(ARGS));
+		append(v_0, v_1, v_rest...);
 	}
 
+	Array& operator=(const Array &p_array) = default;
+	Array& operator=(Array &&p_array) = default;
+
 	//Constructor function
 	void buildarray(VAL *arr, int size)
 	{
@@ -74,33 +45,43 @@ public:
 	}
 
 	//Constructor function
-	static Array<VAL> build_array(VAL *arr, int size)
+	static Array build_array(VAL *arr, int size)
 	{
-		Array<VAL> result;
-		for (int c = 0; c < size; c++)
-			result.push_back(arr[c]);
+		return build_range(arr, arr + size);
+	}
 
-		return result;
+	//Constructor function
+	template<typename IT>
+	static Array build_range(IT p_first, IT p_last)
+	{
+		return Array(V(p_first, p_last));
 	}
 
 	//Methods
 	typename V::iterator begin() { return vec.begin(); }
 	typename V::iterator end() { return vec.end(); }
+	typename V::const_iterator begin() const { return vec.begin(); }
+	typename V::const_iterator end() const { return vec.end(); }
 
 	//Data
 	VAL& at(int ind) const { return vec[ind]; }
 	VAL& get(int ind) { return vec[ind]; }
 	VAL& getlast() { return vec[size() - 1]; }
 	void set(int ind, const VAL &v) { vec[ind] = v; }
+	const VAL* data() const { return vec.data(); }
 	void push_back(const VAL &e) { vec.push_back(e); }
+	void push_back(VAL &&e) { vec.push_back(std::move(e)); }
+	template<typename... ARGS>
+	VAL& emplace_back(ARGS&&... p_args) { vec.emplace_back(std::forward<ARGS>(p_args)...); return vec.back(); }
 	void push_back_ref(const VAL &e) { vec.push_back(e); }
-	void push_back(const Array<VAL> &a) { for (int c = 0; c < a.size(); c++) push_back(a[c]); }
+	void push_back(const Array &a) { for (int c = 0; c < a.size(); c++) push_back(a[c]); }
 	void push_backref(const VAL &e) { vec.push_back(e); }
 	void emplace(const VAL &e) { vec.emplace(vec.begin(), e); }
 	void replace(int index, const VAL &e) { vec[index] = e; }
 	void insert(int index, const VAL &e) { vec.insert(begin() + index, e); }
 	int size() const { return static_cast<int>(vec.size()); }
 	void reserve(int p_size) { vec.reserve(p_size); }
+	void resize(int p_size) { vec.resize(p_size); }
 
 	//Cleaning
 	void clear(int index) { vec.erase(vec.begin() + index); }
@@ -110,20 +91,16 @@ public:
 	//Helper
 	bool contains(const VAL &v) const
 	{
-		for (VAL e : vec)
+		for (const VAL &e : vec)
 			if (v == e)
 				return true;
 		return false;
 	}
-	Array<VAL> split(const int start, const int end) const
+	Array split(const int start, const int end) const
 	{
-		Array<VAL> result;
-		for (int c = start; c <= end; c++)
-			result.push_back(vec[c]);
-
-		return result;
+		return build_range(vec.begin() + start, vec.begin() + end + 1);
 	}
-	Array<VAL> getrest(const int start) const
+	Array getrest(const int start) const
 	{
 		return split(start, size() - 1);
 	}
@@ -142,7 +119,7 @@ public:
 		vec.push_back(e);
 		return *this;
 	}
-	bool operator==(const Array<VAL> &v) const
+	bool operator==(const Array &v) const
 	{
 		if (size() != v.size())
 			return false;
@@ -153,4 +130,14 @@ public:
 
 		return true;
 	}
+
+private:
+	void append() { }
+
+	template<typename... ARGS>
+	void append(const VAL &v, const ARGS&... v_rest)
+	{
+		vec.push_back(v);
+		append(v_rest...);
+	}
 };
\ No newline at end of file
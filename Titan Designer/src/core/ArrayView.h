@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Array.h"
+
+//A read only view of values that are stored somewhere else, like std::span. Functions
+//take a view instead of an Array by value so the caller does not allocate and copy
+//its values. A view must not outlive the values it refers to.
+template<class VAL> class ArrayView
+{
+public:
+	ArrayView() : values(NULL), count(0) { }
+	ArrayView(const VAL *p_values, int p_count) : values(p_values), count(p_count) { }
+	ArrayView(const Array<VAL> &p_array) : values(p_array.data()), count(p_array.size()) { }
+
+	//a single value, usually a temporary argument that lives until the call returns
+	ArrayView(const VAL &p_value) : values(&p_value), count(1) { }
+
+	//Methods
+	const VAL* begin() const { return values; }
+	const VAL* end() const { return values + count; }
+
+	//Data
+	const VAL* data() const { return values; }
+	const VAL& getlast() const { return values[count - 1]; }
+	int size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	//Helper
+	bool contains(const VAL &v) const
+	{
+		for (int c = 0; c < count; c++)
+			if (v == values[c])
+				return true;
+
+		return false;
+	}
+	ArrayView<VAL> split(int start, int end) const
+	{
+		return ArrayView<VAL>(values + start, end - start + 1);
+	}
+	ArrayView<VAL> getrest(int start) const
+	{
+		return split(start, count - 1);
+	}
+
+	//Operators
+	const VAL& operator[](int i) const
+	{
+		return values[i];
+	}
+
+private:
+	const VAL *values;
+	int count;
+};
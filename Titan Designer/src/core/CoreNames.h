@@ -36,6 +36,9 @@ public:
 	const StringName update = "update";
 	const StringName handle_event = "handle_event";
 
+	//builtin functions
+	const StringName print = "print";
+
 	//static
 	static CoreNames* get_singleton();
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "Vector.h"
 
 #include "ScriptNode.h"
@@ -7,25 +9,51 @@
 #include "TMessage.h"
 #include "TsVariable.h"
 #include "CoreNames.h"
-#include "Memory.h"
 #include "String.h"
 #include "Map.h"
+#include "titanscript/Bytecode.h"
+#include "titanscript/ScriptArena.h"
 
 class Line;
 class Function;
 class State;
 class Class;
 
+//Text of a token. It points into the copy of the source the Lexer keeps in the
+//ScriptArena, so tokens and the lines that hold them are copied without allocating.
+struct TokenText
+{
+	TokenText() : src(""), size(0) { }
+	TokenText(const char *p_src, int p_size) : src(p_src), size(p_size) { }
+
+	int length() const { return size; }
+	char operator[](int p_index) const { return src[p_index]; }
+	String substr(int p_start, int p_length) const { return String(src + p_start, p_length); }
+
+	bool operator==(const char *p_text) const { return strncmp(src, p_text, size) == 0 && p_text[size] == 0; }
+	bool operator==(const String &p_text) const { return p_text.length() == size && memcmp(src, p_text.c_str(), size) == 0; }
+	bool operator!=(const char *p_text) const { return !(*this == p_text); }
+	bool operator!=(const String &p_text) const { return !(*this == p_text); }
+
+	operator String() const { return String(src, size); }
+
+	const char *src;
+	int size;
+};
+
 struct Token
 {
-	Token(const String &txt, int t)
+	Token(const TokenText &txt, int t)
 	{
 		text = txt;
 		type = t;
 	}
-	String text;
+	TokenText text;
 	int type = 0;
 
+	//interned text of words and keywords, the Parser compares these by pointer
+	StringName name;
+
 	enum Type
 	{
 		UNDEF,
@@ -38,13 +66,20 @@ struct Token
 	};
 };
 
+typedef Array<Token, ScriptAllocator<Token>> TokenArray;
+
 class Line
 {
 public:
 	Line() { };
-	Line(Array<Token> t) { tokens = t; }
+	Line(const TokenArray &t) { tokens = t; }
 	~Line() {  };
 
+	//lines are placed in the ScriptArena of the script being lexed, their tokens and
+	//sub lines too, so the arena does not destroy them on release
+	static void* operator new(size_t p_size) { return ScriptArena::allocate_current(p_size, NULL); }
+	static void operator delete(void *p_ptr) { ScriptArena::free(p_ptr); }
+
 	void Free()
 	{
 		/*
@@ -60,6 +95,7 @@ public:
 	int size() const { return tokens.size(); }
 	bool StartsWith(const String &txt) const { return tokens[0].text == txt; }
 	bool StartsWith(const int &type) const { return tokens[0].type == type; }
+	bool StartsWithName(const StringName &name) const { return tokens[0].name == name; }
 	bool EndsWith(const String &txt) const { return tokens[size() - 1].text == txt; }
 	bool EndsWith(const int &type) const { return tokens[size() - 1].type == type; }
 	bool Contains(const String &txt) const { return Search(txt) != -1; }
@@ -126,13 +162,27 @@ public:
 
 		return -1;
 	}
+
+	//tokens of the line and its block, reloading compares these to find unchanged lines
+	String get_source() const
+	{
+		String source;
+
+		for (int c = 0; c < tokens.size(); c++)
+			source += String(tokens[c].type) + tokens[c].text + " ";
+
+		for (int c = 0; c < sub.size(); c++)
+			source += "{" + sub[c]->get_source() + "}";
+
+		return source;
+	}
 	
-	Array<String> strings;
-	Array<Token> tokens;
-	Vector<Line> sub;
+	TokenArray tokens;
+	ScriptVector<Line> sub;
 	ScriptNode *node;
 
 	int level = 0;
+	int number = 0;		//source line, 0 for lines built from tokens
 };
 
 class Function
@@ -142,10 +192,18 @@ public:
 	{
 		name = na;
 		block = no;
+		compiled = NULL;
+	}
+	~Function()
+	{
+		delete compiled;
 	}
 
 	String name;
 	Block *block;
+
+	//set by the Compiler, NULL when the function only runs in the Executer
+	CompiledFunction *compiled;
 };
 
 class State
@@ -155,37 +213,49 @@ public:
 
 	void Free()
 	{
-		for (std::pair<String, TsVariable*> v : vars)
-			delete v.second;
-
-		for (std::pair<String, Function*> f : funcs)
-			delete f.second;
-
-		vars.clear();
-		funcs.clear();
+		vars.clean();
+		funcs.clean();
 		poppara.clear();
+		func_version++;
 	}
 
 	bool VarExists(StringName name) { return vars.count(name) > 0; }
 	void AddVar(StringName name) { vars.set(name, new TsVariable(name)); }
 	bool FuncExists(StringName name) { return funcs.count(name) > 0; }
-	void AddFunc(Function *func) { funcs.set(func->name, func); }
+	void AddFunc(Function *func)
+	{
+		if (FuncExists(func->name))							//Redefined by a reload
+			delete funcs[func->name];
 
-	void SetVar(const StringName& name, const Variant &val)
+		funcs.set(func->name, func);
+		func_version++;
+	}
+	void RemoveFunc(const StringName &name)
 	{
-		if (!VarExists(name))
-			AddVar(name);
-		else
+		if (FuncExists(name))
 		{
-			DeleteVar(name);
-			AddVar(name);
+			delete funcs[name];
+			funcs.clear(name);
+			func_version++;
 		}
-		vars[name]->value = val;
+	}
+
+	//changes whenever a function is added or removed, pointers to functions are kept until then
+	int get_func_version() const { return func_version; }
+
+	void SetVar(const StringName& name, const Variant &val)
+	{
+		TsVariable *var = vars.find(name);
+
+		if (!var)
+			var = vars.set(name, new TsVariable(name));
+
+		var->value = val;
 	}
 	Variant* GetVar(const StringName &name)
 	{
-		if (VarExists(name))
-			return &vars[name.get_source()]->value;
+		if (TsVariable *var = vars.find(name))
+			return &var->value;
 		
 		T_ERROR("Var: " + name.operator std::string() + " does not exist!");
 		return NULL;
@@ -194,7 +264,7 @@ public:
 	{
 		if (VarExists(name))
 		{
-			GC->queue_clean(vars[name]->value);
+			vars.clean(name);
 			vars.clear(name);
 		}
 		else
@@ -204,8 +274,8 @@ public:
 	}
 	Function* GetFunc(const StringName &name)
 	{
-		if (FuncExists(name))
-			return funcs[name];
+		if (Function *func = funcs.find(name))
+			return func;
 		else
 			T_ERROR("Func: " + name.operator std::string() + " does not exist!");
 
@@ -255,8 +325,12 @@ public:
 	Variant extension;
 	VariantType extensiontype; //extensions can only inherit Object
 
+	String name;	//file of the script, shown by the profiler
+
 private:
+	int func_version = 0;
+
 	Array<Variant> arg_stack, returnstack, poppara, popreturn;
-	Map<String, TsVariable> vars;
-	Map<String, Function> funcs;
+	Map<StringName, TsVariable> vars;
+	Map<StringName, Function> funcs;
 };
\ No newline at end of file
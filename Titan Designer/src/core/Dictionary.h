@@ -2,6 +2,7 @@
 
 #include <map>
 #include <algorithm>
+#include <tuple>
 
 template<class KEY, class VAL>
 class Dictionary
@@ -12,12 +13,19 @@ private:
 
 public:
 	Dictionary() = default;
-	Dictionary(M v) { mymap = v; }
+	Dictionary(const Dictionary &p_dictionary) = default;
+	Dictionary(Dictionary &&p_dictionary) = default;
+	Dictionary(M v) : mymap(std::move(v)) { }
 	~Dictionary() { clear(); }
 
+	Dictionary& operator=(const Dictionary &p_dictionary) = default;
+	Dictionary& operator=(Dictionary &&p_dictionary) = default;
+
 	//Methods
 	typename M::iterator begin() { return mymap.begin(); }
 	typename M::iterator end() { return mymap.end(); }
+	typename M::const_iterator begin() const { return mymap.begin(); }
+	typename M::const_iterator end() const { return mymap.end(); }
 
 	void clear() { mymap.clear(); }
 	void clear(const KEY &k) { mymap.erase(k); }
@@ -34,8 +42,8 @@ public:
 	}
 	bool contains(const VAL &v) const
 	{
-		for (VAL &e : mymap)
-			if (v == e)
+		for (const std::pair<const KEY, VAL> &e : mymap)
+			if (v == e.second)
 				return true;
 
 		return false;
@@ -47,15 +55,28 @@ public:
 		return val;
 	}
 
+	template<typename... ARGS>
+	VAL& emplace(const KEY &key, ARGS&&... p_args)
+	{
+		return mymap.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<ARGS>(p_args)...)).first->second;
+	}
+
 	VAL& get(const KEY &key)
 	{
 		return mymap[key];
 	}
 
+	//NULL when there is no value for key
+	VAL* find(const KEY &key)
+	{
+		typename M::iterator i = mymap.find(key);
+		return i != mymap.end() ? &i->second : NULL;
+	}
+
 	//Operators
 	const VAL& operator[](const KEY &key) const
 	{
-		return mymap[key];
+		return mymap.at(key);
 	}
 	VAL& operator[](const KEY &key)
 	{
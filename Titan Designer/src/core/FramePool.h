@@ -0,0 +1,52 @@
+#pragma once
+
+#include <new>
+#include <utility>
+
+#include "Array.h"
+
+//Objects of type T that live until the end of the frame. The pool keeps the objects of
+//earlier frames and constructs new ones in their memory, after the first frames creating
+//an object does not allocate. Pointers to the objects are invalid after reset()
+template<typename T>
+class FramePool
+{
+public:
+	FramePool() = default;
+	FramePool(const FramePool &p_pool) = delete;
+
+	~FramePool()
+	{
+		for (T *object : objects)
+			delete object;
+	}
+
+	FramePool& operator=(const FramePool &p_pool) = delete;
+
+	template<typename... ARGS>
+	T* create(ARGS&&... p_args)
+	{
+		if (used == objects.size())
+			objects.push_back(new T(std::forward<ARGS>(p_args)...));
+		else
+		{
+			T *object = objects[used];
+			object->~T();
+			new (object) T(std::forward<ARGS>(p_args)...);
+		}
+
+		return objects[used++];
+	}
+
+	//all objects are free to be reused
+	void reset()
+	{
+		used = 0;
+	}
+
+	int size() const { return used; }
+
+private:
+	Array<T*> objects;
+	int used = 0;
+};
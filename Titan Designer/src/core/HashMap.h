@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Array.h"
+#include "String.h"
+
+//hash of a key, names and strings use the hash they already have
+template<class KEY> struct HashMapHasher
+{
+	static size_t hash(const KEY &p_key) { return std::hash<KEY>{}(p_key); }
+};
+
+template<> struct HashMapHasher<String>
+{
+	static size_t hash(const String &p_key) { return p_key.get_hash(); }
+};
+
+template<> struct HashMapHasher<StringName>
+{
+	static size_t hash(const StringName &p_key) { return p_key.get_hash(); }
+};
+
+//A flat hash map with Robin Hood probing, for tables that do not need their keys in
+//order. The pairs are stored next to each other in the order they were added, the
+//slots only keep the hash and the index of their pair. Adding or removing a pair moves
+//the others, references to values are only valid until the map changes
+template<class KEY, class VAL>
+class HashMap
+{
+public:
+	typedef std::pair<KEY, VAL> Pair;
+
+	HashMap() = default;
+	HashMap(const HashMap &p_map) = default;
+	HashMap(HashMap &&p_map) = default;
+
+	HashMap& operator=(const HashMap &p_map) = default;
+	HashMap& operator=(HashMap &&p_map) = default;
+
+	//Methods
+	typename std::vector<Pair>::iterator begin() { return pairs.begin(); }
+	typename std::vector<Pair>::iterator end() { return pairs.end(); }
+	typename std::vector<Pair>::const_iterator begin() const { return pairs.begin(); }
+	typename std::vector<Pair>::const_iterator end() const { return pairs.end(); }
+
+	void clear()
+	{
+		pairs.clear();
+		slots.clear();
+		bits = 0;
+	}
+	void clear(const KEY &p_key)
+	{
+		int slot = find_slot(p_key, HashMapHasher<KEY>::hash(p_key));
+
+		if (slot >= 0)
+			erase_slot(slot);
+	}
+	int size() const { return pairs.size(); }
+
+	void reserve(int p_size)
+	{
+		while (p_size * 5 > slots.size() * 4)
+			grow();
+	}
+
+	//Cleaning
+	int count(const KEY &p_key) const
+	{
+		return contains(p_key) ? 1 : 0;
+	}
+	bool contains(const KEY &p_key) const
+	{
+		return find_slot(p_key, HashMapHasher<KEY>::hash(p_key)) >= 0;
+	}
+	bool contains_value(const VAL &p_val) const
+	{
+		for (const Pair &pair : pairs)
+			if (p_val == pair.second)
+				return true;
+
+		return false;
+	}
+
+	//NULL when there is no value for p_key
+	VAL* find(const KEY &p_key)
+	{
+		int slot = find_slot(p_key, HashMapHasher<KEY>::hash(p_key));
+		return slot >= 0 ? &pairs[slots[slot].index].second : NULL;
+	}
+	const VAL* find(const KEY &p_key) const
+	{
+		int slot = find_slot(p_key, HashMapHasher<KEY>::hash(p_key));
+		return slot >= 0 ? &pairs[slots[slot].index].second : NULL;
+	}
+
+	VAL set(const KEY &p_key, const VAL &p_val)
+	{
+		get(p_key) = p_val;
+		return p_val;
+	}
+
+	//like std::map, an existing value is kept
+	template<typename... ARGS>
+	VAL& emplace(const KEY &p_key, ARGS&&... p_args)
+	{
+		size_t hash = HashMapHasher<KEY>::hash(p_key);
+		int slot = find_slot(p_key, hash);
+
+		if (slot >= 0)
+			return pairs[slots[slot].index].second;
+
+		return add(hash, std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(std::forward<ARGS>(p_args)...));
+	}
+
+	//adds a default value when there is none yet
+	VAL& get(const KEY &p_key)
+	{
+		return emplace(p_key);
+	}
+
+	VAL& at(const KEY &p_key)
+	{
+		VAL *val = find(p_key);
+
+		if (!val)
+			throw std::out_of_range("HashMap::at");
+
+		return *val;
+	}
+	const VAL& at(const KEY &p_key) const
+	{
+		const VAL *val = find(p_key);
+
+		if (!val)
+			throw std::out_of_range("HashMap::at");
+
+		return *val;
+	}
+
+	//Operators
+	const VAL& operator[](const KEY &p_key) const
+	{
+		return at(p_key);
+	}
+	VAL& operator[](const KEY &p_key)
+	{
+		return get(p_key);
+	}
+
+private:
+	struct Slot
+	{
+		size_t hash = 0;
+		int index = 0;
+		int distance = 0;			//0 when empty, else one more than the steps from the home slot
+	};
+
+	//Fibonacci hashing spreads keys whose hashes only differ in the high bits, like pointers
+	int get_home(size_t p_hash) const
+	{
+		return static_cast<int>((static_cast<uint64_t>(p_hash) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+	}
+
+	int find_slot(const KEY &p_key, size_t p_hash) const
+	{
+		if (pairs.size() == 0)
+			return -1;
+
+		int mask = slots.size() - 1;
+		int c = get_home(p_hash);
+
+		//the pairs in a probe sequence are ordered by distance, a closer one ends the search
+		for (int distance = 1; slots[c].distance >= distance; distance++)
+		{
+			const Slot &slot = slots[c];
+
+			if (slot.hash == p_hash && pairs[slot.index].first == p_key)
+				return c;
+
+			c = (c + 1) & mask;
+		}
+
+		return -1;
+	}
+
+	template<typename... ARGS>
+	VAL& add(size_t p_hash, ARGS&&... p_args)
+	{
+		//at most 80% of the slots are used
+		if ((pairs.size() + 1) * 5 > slots.size() * 4)
+			grow();
+
+		Slot slot;
+		slot.hash = p_hash;
+		slot.index = pairs.size();
+
+		pairs.emplace_back(std::forward<ARGS>(p_args)...);
+		insert(slot);
+
+		return pairs.getlast().second;
+	}
+
+	//takes from the rich: a pair that is further from its home slot takes the place
+	void insert(Slot p_slot)
+	{
+		int mask = slots.size() - 1;
+		int c = get_home(p_slot.hash);
+
+		p_slot.distance = 1;
+
+		while (slots[c].distance)
+		{
+			if (slots[c].distance < p_slot.distance)
+				std::swap(slots[c], p_slot);
+
+			p_slot.distance++;
+			c = (c + 1) & mask;
+		}
+
+		slots[c] = p_slot;
+	}
+
+	void erase_slot(int p_slot)
+	{
+		int mask = slots.size() - 1;
+		int index = slots[p_slot].index;
+		int last = pairs.size() - 1;
+
+		//the last pair fills the hole, its slot points to the new index
+		if (index != last)
+		{
+			slots[find_index_slot(last)].index = index;
+			pairs[index] = std::move(pairs[last]);
+		}
+
+		pairs.removelast();
+
+		//shift the following pairs of the probe sequence one step back
+		int c = p_slot;
+		int next = (c + 1) & mask;
+
+		while (slots[next].distance > 1)
+		{
+			slots[c] = slots[next];
+			slots[c].distance--;
+
+			c = next;
+			next = (next + 1) & mask;
+		}
+
+		slots[c] = Slot();
+	}
+
+	int find_index_slot(int p_index) const
+	{
+		int mask = slots.size() - 1;
+		size_t hash = HashMapHasher<KEY>::hash(pairs[p_index].first);
+		int c = get_home(hash);
+
+		while (slots[c].index != p_index || !slots[c].distance)
+			c = (c + 1) & mask;
+
+		return c;
+	}
+
+	void grow()
+	{
+		Array<Slot> old = std::move(slots);
+
+		bits = bits ? bits + 1 : 3;
+
+		slots.clear();
+		slots.resize(1 << bits);
+
+		for (const Slot &slot : old)
+			if (slot.distance)
+				insert(slot);
+	}
+
+	Array<Pair> pairs;
+	Array<Slot> slots;
+	int bits = 0;					//the slot count is 1 << bits
+};
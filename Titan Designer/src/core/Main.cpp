@@ -8,6 +8,8 @@ Platforms: Android, Linux, Mac OS X and Windows
 
 #include "game/GameApp.h"
 #include "editor/EditorApp.h"
+#include "tests/TestApp.h"
+#include "tests/Test.h"
 #include "core/platform/Windows.h"
 
 #undef main
@@ -17,7 +19,12 @@ Platforms: Android, Linux, Mac OS X and Windows
 
 int main(int argc, char* argv[])
 {
-#if EDITOR
+#if TESTS
+	TestApp tests(new Windows);
+	tests.Loop();
+
+	return tests.get_failures() ? 1 : 0;
+#elif EDITOR
 	EditorApp editor(new Windows);
 	editor.Loop();
 #else
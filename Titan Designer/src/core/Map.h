@@ -3,51 +3,48 @@
 #include <map>
 #include <algorithm>
 
+#include "HashMap.h"
+
+//Owns pointers to its values, the keys are hashed and kept in the order they were added
 template<class KEY, class VAL> class Map
 {
 private:
-	typedef std::map<KEY, VAL*> M;
+	typedef HashMap<KEY, VAL*> M;
 	M map;
 
 public:
 	Map() = default;
-	Map(M p_val) { map = p_val; }
+	Map(M p_val) : map(std::move(p_val)) { }
 
 	//Methods
-	typename M::iterator begin() { return map.begin(); }
-	typename M::iterator end() { return map.end(); }
+	typename std::vector<typename M::Pair>::iterator begin() { return map.begin(); }
+	typename std::vector<typename M::Pair>::iterator end() { return map.end(); }
 
 	void clear() { map.clear(); }
 
-	void clear(const KEY &p_key) { map.erase(p_key); }
+	void clear(const KEY &p_key) { map.clear(p_key); }
 	void clean(const KEY &p_key) { delete map[p_key]; }
-	int size() const { return to_int(map.size()); }
+	int size() const { return map.size(); }
 
 	//Cleaning
-	int count(const KEY &p_key)
+	int count(const KEY &p_key) const
 	{
-		return static_cast<int>(map.count(p_key));
+		return map.count(p_key);
 	}
 	void clean()
 	{
-		for_each(map.begin(), map.end(), [](pair<const KEY&, VAL*> p_pair) { delete p_pair.second; });
+		for (const typename M::Pair &pair : map)
+			delete pair.second;
 
 		map.clear();
 	}
 	bool contains(const KEY &p_key) const
 	{
-		if (map.count(p_key) > 0)
-			return true;
-
-		return false;
+		return map.contains(p_key);
 	}
 	bool contains(VAL *p_val) const
 	{
-		for (VAL* e : map) 
-			if (p_val == e)
-				return true;
-
-		return false;
+		return map.contains_value(p_val);
 	}
 
 	VAL* set(const KEY &p_key, VAL* p_val)
@@ -61,6 +58,13 @@ public:
 		return map.at(p_key);
 	}
 
+	//NULL when there is no value for p_key
+	VAL* find(const KEY &p_key) const
+	{
+		VAL *const *val = map.find(p_key);
+		return val ? *val : NULL;
+	}
+
 	//Operators
 	VAL*& operator[](const KEY &p_key) { return map.at(p_key); }
 	VAL* operator[](const KEY &p_key) const { return map.at(p_key); }
@@ -1,10 +1,14 @@
 #include "Node.h"
 
-#include "Memory.h"
+#include "core/titanscript/CommandBuffer.h"
 
 Node::Node()
 {
-
+	parent = NULL;
+	subtree_version = 1;
+	found_children_version = 0;
+	found_paths_root = NULL;
+	found_paths_version = 0;
 }
 
 Node::~Node()
@@ -24,18 +28,18 @@ void Node::add_child(Node* p_child)
 		p_child->name = p_child->get_type_name();
 
 	children.push_back(p_child);
+	index_child(p_child);
 
 	p_child->parent = this;
 	p_child->children_changed();
 	
-	if (p_child->has_script())
-		p_child->run("ready", {});
+	p_child->run_callback(LIFECYCLE_READY, Arguments());
 }
 
 void Node::remove_child(Node* p_child)
 {
 	p_child->clean();
-	GC->queue_clean(p_child);
+	unindex_child(p_child);
 	children.clear(p_child);
 	children_changed();
 }
@@ -46,9 +50,57 @@ void Node::clean()
 	for (int c = 0; c < size; c++)
 	{
 		Node* child = get_child_by_index(0);
-		GC->queue_clean(child);
 		children.clear(child);
 	}
+
+	clear_child_index();
+}
+
+//an earlier child with the same name stays in the index
+void Node::index_child(Node *p_child)
+{
+	StringName name = p_child->name;
+	Node **indexed = child_index.find(name);
+
+	if (!indexed || get_index(p_child) < get_index(*indexed))
+		child_index.set(name, p_child);
+
+	subtree_changed();
+}
+
+//the next child with the same name takes its place
+void Node::unindex_child(Node *p_child)
+{
+	StringName name = p_child->name;
+	Node **indexed = child_index.find(name);
+
+	if (indexed && *indexed == p_child)
+	{
+		child_index.clear(name);
+
+		for (int c = 0; c < children.size(); c++)
+		{
+			if (children[c] != p_child && children[c]->name == p_child->name)
+			{
+				child_index.set(name, children[c]);
+				break;
+			}
+		}
+	}
+
+	subtree_changed();
+}
+
+void Node::clear_child_index()
+{
+	child_index.clear();
+	subtree_changed();
+}
+
+void Node::subtree_changed()
+{
+	for (Node *node = this; node; node = node->parent)
+		node->subtree_version++;
 }
 
 Node* Node::get_child_by_index(int p_index)
@@ -58,19 +110,124 @@ Node* Node::get_child_by_index(int p_index)
 
 Node* Node::get_child(const String& p_name)
 {
+	StringName name = p_name;
+
+	if (Node **child = child_index.find(name))
+		return *child;
+
+	bool cache = validate_found_children();
+
+	if (cache)
+		if (Node **found = found_children.find(name))
+			return *found;
+
 	for (int c = 0; c < children.size(); c++)
 	{
-		if (children[c]->name == p_name)
-			return children[c];
+		if (Node *n = children[c]->find_descendant(name))
+		{
+			if (cache)
+				found_children.set(name, n);
 
-		Node* n = children[c]->get_child(p_name);
-		if (n)
 			return n;
+		}
 	}
 
 	return NULL;
 }
 
+Node* Node::find_descendant(const StringName &p_name)
+{
+	if (Node **child = child_index.find(p_name))
+		return *child;
+
+	for (int c = 0; c < children.size(); c++)
+		if (Node *n = children[c]->find_descendant(p_name))
+			return n;
+
+	return NULL;
+}
+
+Node* Node::get_root()
+{
+	Node *node = this;
+
+	while (node->parent)
+		node = node->parent;
+
+	return node;
+}
+
+Node* Node::get_node(const String& p_path)
+{
+	bool cache = validate_found_paths();
+
+	if (cache)
+		if (Node **found = found_paths.find(p_path))
+			return *found;
+
+	Node *node = this;
+
+	if (p_path.size() > 0 && p_path[0] == '/')
+		node = get_root();
+
+	for (const String &part : p_path.split('/'))
+	{
+		if (part == "" || part == ".")
+			continue;
+
+		if (part == "..")
+			node = node->parent;
+		else
+		{
+			Node **child = node->child_index.find(part);
+			node = child ? *child : NULL;
+		}
+
+		if (!node)
+			return NULL;
+	}
+
+	if (cache)
+		found_paths.set(p_path, node);
+
+	return node;
+}
+
+//drops the found children when a node below this one changed, false on the workers of a
+//parallel update because they only read the trees
+bool Node::validate_found_children()
+{
+	if (CommandBuffer::current)
+		return false;
+
+	if (found_children_version != subtree_version)
+	{
+		found_children.clear();
+		found_children_version = subtree_version;
+	}
+
+	return true;
+}
+
+//paths can lead up to the root, they are dropped when anything in the tree changed
+//or the node was moved to another tree
+bool Node::validate_found_paths()
+{
+	if (CommandBuffer::current)
+		return false;
+
+	Node *root = get_root();
+
+	if (found_paths_root != root || found_paths_version != root->subtree_version)
+	{
+		found_paths.clear();
+		found_paths_root = root;
+		found_paths_version = root->subtree_version;
+	}
+
+	return true;
+}
+
 int Node::get_child_count() const
 {
 	return children.size();
@@ -83,7 +240,22 @@ Node* Node::get_parent() const
 
 void Node::set_name(const String& p_name)
 {
+	//workers of a parallel update read the index of the parent, the rename waits for the batch
+	if (CommandBuffer::current)
+	{
+		Variant args[] = { this, p_name };
+		CommandBuffer::current->call(MMASTER->get_method(get_type(), StringName("set_name")), args, 2);
+		return;
+	}
+
+	if (parent)
+		parent->unindex_child(this);
+
 	name = p_name;
+
+	if (parent)
+		parent->index_child(this);
+
 	children_changed();
 }
 
@@ -112,6 +284,7 @@ void Node::bind_methods()
 {
 	REG_PROPERTY(name);
 	REG_METHOD(get_child);
+	REG_METHOD(get_node);
 	REG_METHOD(get_parent);
 
 	REG_SIGNAL("children_changed");
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/HashMap.h"
 #include "types/Scriptable.h"
 
 class Node : public Scriptable
@@ -16,8 +17,13 @@ public:
 	void clean();
 
 	Node* get_child_by_index(int p_index);
+
+	//a direct child first, then the first match in the subtrees in order
 	Node* get_child(const String& p_name);
 
+	//child names split by '/', ".." is the parent and a leading '/' starts at the root
+	Node* get_node(const String& p_path);
+
 	
 	template<typename T>
 	T get_child_by_type()
@@ -47,12 +53,39 @@ public:
 	static void bind_methods();
 
 protected:
+	//subclasses that change children themselves keep the index up to date with these
+	void index_child(Node *p_child);
+	void unindex_child(Node *p_child);
+	void clear_child_index();
+
 	Node* parent;
 	Vector<Node> children;
 
 	String name;
 
-
 private:
+	Node* find_descendant(const StringName &p_name);
+	Node* get_root();
+
+	//raises the subtree version of this node and its ancestors
+	void subtree_changed();
+
+	bool validate_found_children();
+	bool validate_found_paths();
+
+	//the first child with each name
+	HashMap<StringName, Node*> child_index;
+
+	//changes when a node is added, removed or renamed below this node
+	unsigned subtree_version;
+
+	//found nodes, children are dropped when the subtree of this node changed and
+	//paths when the tree it is in changed
+	HashMap<StringName, Node*> found_children;
+	unsigned found_children_version;
+
+	HashMap<String, Node*> found_paths;
+	Node *found_paths_root;
+	unsigned found_paths_version;
 };
 
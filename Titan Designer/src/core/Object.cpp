@@ -33,7 +33,7 @@ bool Object::is_type_ptr(void *ptr) const
 
 VariantType Object::get_type() const
 {
-	return CORE_TYPE(Object);
+	return VariantType(Variant::OBJECT);
 }
 
 StringName Object::get_type_name_static()
@@ -52,4 +52,8 @@ void* Object::get_type_ptr_static()
 bool Object::is_type_static(void* ptr)
 {
 	return ptr == Object::get_type_ptr_static();
+}
+int Object::get_type_id_static()
+{
+	return Variant::OBJECT;
 }
\ No newline at end of file
@@ -26,7 +26,7 @@ public:\
 	}\
 	VariantType get_type() const override\
 	{\
-		return GETTYPE(StringName(#NAME));\
+		return VariantType(NAME::get_type_id_static());\
 	}\
 \
 	String get_type_path() const override\
@@ -59,6 +59,11 @@ public:\
 	{\
 		return ptr == get_type_ptr_static();\
 	}\
+	static int get_type_id_static()\
+	{\
+		static int id = TYPEMAN->get_type_id(#NAME);\
+		return id;\
+	}\
 \
 private:
 
@@ -105,4 +110,11 @@ public:
 	static String get_type_path_static();
 	static void* get_type_ptr_static();
 	static bool is_type_static(void* ptr);
+	static int get_type_id_static();
+
+	//set for the objects that derive from Referenced, Variants that hold them count a reference
+	bool is_reference_counted() const { return reference_counted; }
+
+protected:
+	bool reference_counted = false;
 };
\ No newline at end of file
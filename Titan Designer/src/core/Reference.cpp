@@ -1,10 +1,20 @@
 #include "Reference.h"
 
-#include "Memory.h"
-
 Referenced::Referenced()
 {
 	ref_count = 0;
+	owned_by_references = false;
+	reference_counted = true;
+}
+
+//a copy is a new object, nothing references it yet
+Referenced::Referenced(const Referenced &p_r) : Referenced()
+{
+}
+
+Referenced& Referenced::operator=(const Referenced &p_r)
+{
+	return *this;
 }
 
 void Referenced::increase_ref_count()
@@ -14,8 +24,33 @@ void Referenced::increase_ref_count()
 
 void Referenced::decrease_ref_count()
 {
-	ref_count--;
+	if (--ref_count == 0 && owned_by_references)
+		delete this;
+}
+
+int Referenced::get_ref_count() const
+{
+	return ref_count;
+}
 
-	if (ref_count == 0)
-		GC->queue_clean(this);
+void Referenced::set_owned_by_references(bool p_owned)
+{
+	owned_by_references = p_owned;
+}
+
+bool Referenced::is_owned_by_references() const
+{
+	return owned_by_references;
+}
+
+void Referenced::reference(Object *p_object)
+{
+	if (p_object && p_object->is_reference_counted())
+		static_cast<Referenced*>(p_object)->increase_ref_count();
+}
+
+void Referenced::unreference(Object *p_object)
+{
+	if (p_object && p_object->is_reference_counted())
+		static_cast<Referenced*>(p_object)->decrease_ref_count();
 }
@@ -1,23 +1,39 @@
 #pragma once
 
+#include <atomic>
+
 #include "core/Object.h"
 
+//An object with an intrusive reference count, Variants and Refs that hold it count
+//themselves. Objects that are owned by their references are deleted as soon as the
+//last one lets go, the others only count, something else still owns and deletes them
 class Referenced : public Object
 {
 	OBJ_DEFINITION(Referenced, Object);
 
 public:
 	Referenced();
+	Referenced(const Referenced &p_r);
+
+	Referenced& operator=(const Referenced &p_r);
 
 	void increase_ref_count();
 	void decrease_ref_count();
+	int get_ref_count() const;
+
+	void set_owned_by_references(bool p_owned);
+	bool is_owned_by_references() const;
 
+	//count a reference to p_object when it is a Referenced
+	static void reference(Object *p_object);
+	static void unreference(Object *p_object);
 
 private:
-	int ref_count;
+	std::atomic<int> ref_count;
+	bool owned_by_references;
 };
 
-//T derives from Referenced
+//T derives from Object, only Referenced objects are counted
 template<typename T>
 class Ref
 {
@@ -26,6 +42,7 @@ public:
 	inline Ref(T* p_ref)
 	{
 		referenced = p_ref;
+		Referenced::reference(referenced);
 	}
 
 	inline Ref() : Ref(NULL)
@@ -33,31 +50,49 @@ public:
 
 	}
 
-	inline ~Ref()
+	inline Ref(const Ref<T>& p_r) : Ref(p_r.referenced)
 	{
-		if (referenced)
-		{
-			Referenced* ref = reinterpret_cast<Referenced*>(referenced);
 
-			ref->decrease_ref_count();
-		}
 	}
 
-	inline void ref(const Ref& p_new)
+	inline Ref(Ref<T>&& p_r)
 	{
+		referenced = p_r.referenced;
+		p_r.referenced = NULL;
+	}
 
+	inline ~Ref()
+	{
+		Referenced::unreference(referenced);
 	}
 
-	inline void operator=(const Ref<T>& p_r)
+	//a new T that is deleted with the last reference to it
+	template<typename... Args>
+	static Ref<T> create(Args&&... p_args)
 	{
-		referenced = p_r.referenced;
+		T *object = new T(std::forward<Args>(p_args)...);
+		object->set_owned_by_references(true);
 
-		if (!referenced)
-			return;
+		return Ref<T>(object);
+	}
+
+	inline Ref<T>& operator=(const Ref<T>& p_r)
+	{
+		Ref<T> value(p_r);
+		return *this = std::move(value);
+	}
 
-		Referenced* ref = reinterpret_cast<Referenced*>(referenced);
+	inline Ref<T>& operator=(Ref<T>&& p_r)
+	{
+		if (this == &p_r)
+			return *this;
+
+		T *old = referenced;
+		referenced = p_r.referenced;
+		p_r.referenced = NULL;
 
-		ref->increase_ref_count();
+		Referenced::unreference(old);
+		return *this;
 	}
 
 	inline bool operator<(const Ref<T>& p_r) const
@@ -112,4 +147,4 @@ public:
 
 private:
 	T* referenced;
-};
\ No newline at end of file
+};
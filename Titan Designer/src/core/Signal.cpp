@@ -11,26 +11,50 @@
 //=========================================================================
 
 
+Connection::Connection()
+{
+	method = NULL;
+	object = NULL;
+	scriptable = NULL;
+	type = UNDEF;
+	thunk = call_undefined;
+}
+
 void Connection::register_native_method(Object *p_object, const StringName &p_method_name)
 {
 	type = NATIVE;
 
 	object = p_object;
-	method = reinterpret_cast<V_Method_1*>(MMASTER->get_method(object->get_type(), p_method_name));
+	name = p_method_name;
+	method = MMASTER->get_method(object->get_type(), p_method_name);
 
 	if (!method)
 	{
 		String type = object->get_type_name().get_source();
 		T_ERROR("Could not find method: " + p_method_name + " for object of type: " + type);
+		thunk = call_undefined;
 	}
+	else
+		thunk = call_native;
 }
 
+//a native method of the scriptable is bound now, a function of its script is run by name
+//because scripts are reloaded and the script can be set after connecting
 void Connection::register_script_method(Scriptable *p_scriptable, const StringName &p_method_name)
 {
 	type = TITANSCRIPT;
 
 	scriptable = p_scriptable;
 	name = p_method_name;
+	method = MMASTER->get_method(scriptable->get_type(), p_method_name);
+
+	if (method)
+	{
+		object = p_scriptable;
+		thunk = call_native;
+	}
+	else
+		thunk = call_script;
 }
 
 void Connection::register_signal(Scriptable* p_scriptable, const StringName& p_signal_name)
@@ -39,12 +63,14 @@ void Connection::register_signal(Scriptable* p_scriptable, const StringName& p_s
 
 	scriptable = p_scriptable;
 	name = p_signal_name;
+	thunk = call_signal;
 }
 
 void Connection::register_lambda(Method* p_lambda)
 {
 	type = LAMBDA;
 	method = p_lambda;
+	thunk = p_lambda ? call_lambda : call_undefined;
 }
 
 Connection Connection::create_from_native_method(Object* p_object, const StringName& p_method_name)
@@ -57,7 +83,7 @@ Connection Connection::create_from_native_method(Object* p_object, const StringN
 Connection Connection::create_from_script_method(Scriptable* p_scriptable, const StringName& p_method_name)
 {
 	Connection c;
-	c.register_signal(p_scriptable, p_method_name);
+	c.register_script_method(p_scriptable, p_method_name);
 	return c;
 }
 
@@ -75,6 +101,64 @@ Connection Connection::create_from_lambda(Method* p_lambda)
 	return c;
 }
 
+void Connection::call_undefined(const Connection &p_connection, const Variant *p_args, int p_arg_count)
+{
+	T_ERROR("connection " + p_connection.name.get_source() + " has no method");
+}
+
+void Connection::call_native(const Connection &p_connection, const Variant *p_args, int p_arg_count)
+{
+	if (p_connection.method->arg_count != p_arg_count + 1)
+	{
+		T_ERROR("argument count does not match for method: " + p_connection.name);
+		return;
+	}
+
+	Variant args[MAX_METHOD_ARGS];
+	Variant result;
+
+	args[0] = p_connection.object;
+
+	for (int c = 0; c < p_arg_count; c++)
+		args[c + 1] = p_args[c];
+
+	p_connection.method->call(args, result);
+}
+
+void Connection::call_script(const Connection &p_connection, const Variant *p_args, int p_arg_count)
+{
+	TitanScript *script = p_connection.scriptable->get_script();
+
+	if (!script)
+	{
+		T_ERROR("Invalid function call: " + p_connection.name);
+		return;
+	}
+
+	script->RunFunction(p_connection.name, Arguments(p_args, p_arg_count));
+}
+
+//a lambda may ignore the arguments of the signal
+void Connection::call_lambda(const Connection &p_connection, const Variant *p_args, int p_arg_count)
+{
+	if (p_connection.method->arg_count > p_arg_count)
+	{
+		T_ERROR("argument count does not match for lambda connected to: " + p_connection.name);
+		return;
+	}
+
+	Variant result;
+	p_connection.method->call(p_args, result);
+}
+
+void Connection::call_signal(const Connection &p_connection, const Variant *p_args, int p_arg_count)
+{
+	if (p_arg_count == 0)
+		p_connection.scriptable->emit_signal(p_connection.name);
+	else
+		p_connection.scriptable->emit_signal(p_connection.name, p_args[0]);
+}
+
 //=========================================================================
 //Signal
 //=========================================================================
@@ -124,76 +208,30 @@ void Signal::attach_lambda_connection(Method* p_lambda)
 	connections.push_back(connection);
 }
 
-void Signal::emit()
-{
-	for (Connection &connection : connections)
-		emit_connection(connection);
-}
-
-void Signal::emit(Variant arg_0)
+void Signal::detach_connection(const Method *p_method)
 {
-	for (Connection &connection : connections)
-		emit_connection(connection, arg_0);
+	for (int c = connections.size() - 1; c >= 0; c--)
+		if (connections[c].method == p_method)
+			connections.clear(c);
 }
 
-void Signal::emit_connection(const Connection& p_connection) const
+//scripts that wait on this signal attach and detach connections while it is emitting,
+//so they are copied out and the ones added during the emission are skipped
+void Signal::emit(const Variant *p_args, int p_arg_count)
 {
-	Connection* c = const_cast<Connection*>(&p_connection);
-
-	if (!p_connection.method)
-	{
-		T_ERROR("connection " + p_connection.name + " has no method for signal: " + name);
-		return;
-	}
-
-	if (p_connection.type == Connection::NATIVE)
-	{
-		if (p_connection.method->arg_count == 1)
-		{
-			V_Method_1* m = reinterpret_cast<V_Method_1*>(p_connection.method);
-			m->operator() (p_connection.object);
-		}
-		else
-			T_ERROR("argument count does not match");
-	}
-	else if (p_connection.type == Connection::LAMBDA)
+	for (int c = 0, count = connections.size(); c < count && c < connections.size(); c++)
 	{
-		V_Method_0* m = reinterpret_cast<V_Method_0*>(p_connection.method);
-		m->operator()();
+		Connection connection = connections[c];
+		connection.call(p_args, p_arg_count);
 	}
-	else if (p_connection.type == Connection::TITANSCRIPT)
-		p_connection.scriptable->run(p_connection.name, Arguments());
-	else if (p_connection.type == Connection::SIGNAL)
-		p_connection.scriptable->emit_signal(p_connection.name);
-	else
-		(*c).method->operator()({ });
 }
 
-void Signal::emit_connection(const Connection& p_connection, Variant arg_0) const
+void Signal::emit()
 {
-	if (!p_connection.method)
-	{
-		T_ERROR("connection " + p_connection.name + " has no method for signal: " + name);
-		return;
-	}
+	emit(NULL, 0);
+}
 
-	if (p_connection.type == Connection::NATIVE)
-	{
-		if (p_connection.method->arg_count == 2)
-		{
-			V_Method_2* m = reinterpret_cast<V_Method_2*>(p_connection.method);
-			m->operator() (p_connection.object, arg_0);
-		}
-		else
-			T_ERROR("argument count does not match");
-	}
-	else if (p_connection.type == Connection::LAMBDA)
-	{
-		V_Method_1* m = reinterpret_cast<V_Method_1*>(p_connection.method);
-		m->operator()(arg_0);
-	}
-	else if (p_connection.type == Connection::TITANSCRIPT)
-		p_connection.scriptable->run(p_connection.name, Arguments(arg_0));
-	else if (p_connection.type == Connection::SIGNAL)
-		p_connection.scriptable->emit_signal(p_connection.name, Arguments(arg_0));
+void Signal::emit(const Variant &arg_0)
+{
+	emit(&arg_0, 1);
 }
@@ -4,10 +4,15 @@
 
 class Scriptable;
 class TitanScript;
+struct Connection;
+
+//Calls the target of a connection with the arguments of the signal, chosen when the
+//connection is registered so emitting does not look anything up
+typedef void(*ConnectionThunk)(const Connection &p_connection, const Variant *p_args, int p_arg_count);
 
 struct Connection
 {
-	Connection() { type = UNDEF; }
+	Connection();
 	~Connection() { }
 
 	void register_native_method(Object *p_object, const StringName &p_method_name);
@@ -21,6 +26,8 @@ struct Connection
 	static Connection create_from_signal(Scriptable *p_scriptable, const StringName &p_signal_name);
 	static Connection create_from_lambda(Method* p_lambda);
 
+	void call(const Variant *p_args, int p_arg_count) const { thunk(*this, p_args, p_arg_count); }
+
 	Method* method;
 	Object* object;
 	Scriptable* scriptable;
@@ -36,6 +43,14 @@ struct Connection
 	};
 
 	ConnectionType type;
+	ConnectionThunk thunk;
+
+private:
+	static void call_undefined(const Connection &p_connection, const Variant *p_args, int p_arg_count);
+	static void call_native(const Connection &p_connection, const Variant *p_args, int p_arg_count);
+	static void call_script(const Connection &p_connection, const Variant *p_args, int p_arg_count);
+	static void call_lambda(const Connection &p_connection, const Variant *p_args, int p_arg_count);
+	static void call_signal(const Connection &p_connection, const Variant *p_args, int p_arg_count);
 };
 
 class Signal
@@ -58,13 +73,14 @@ public:
 	//lambda
 	void attach_lambda_connection(Method* p_lambda);
 
+	//removes the connections that call p_method
+	void detach_connection(const Method *p_method);
+
+	//the arguments stay on the stack of the caller
 	void emit();
-	void emit(Variant arg_0);
+	void emit(const Variant &arg_0);
+	void emit(const Variant *p_args, int p_arg_count);
 
 	Array<Connection> connections;
 	StringName name;
-
-private:
-	void emit_connection(const Connection &p_connection) const;
-	void emit_connection(const Connection &p_connection, Variant arg_0) const;
 };
\ No newline at end of file
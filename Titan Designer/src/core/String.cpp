@@ -19,6 +19,11 @@ String::String(const char *v)
 	src = std::string(v);
 }
 
+String::String(const char *v, int length)
+{
+	src.assign(v, length);
+}
+
 String::String(std::string v)
 {
 	src = v;
@@ -159,7 +164,7 @@ const char* String::c_str() const
 }
 size_t String::get_hash() const
 {
-	return std::hash<std::string>{}((std::string)src);
+	return std::hash<std::string>{}(src);
 }
 void String::set(int i, char c)
 {
@@ -488,34 +493,53 @@ String String::RemoveTabs()
 //StringName
 //=========================================================================
 
-StringName::StringName(const String &p_src)
-{
-	set_source(p_src);
-} 
+#define STRINGNAME_BUCKETS 4096
 
-void StringName::update_hash()
-{
-	hash = std::hash<std::string>{}((std::string)src);
-}
+std::atomic<StringName::Entry*> StringName::buckets[STRINGNAME_BUCKETS];
 
-size_t StringName::get_hash() const
+StringName::StringName()
 {
-	return hash;
+	static const Entry *empty = intern(String());
+	entry = empty;
 }
 
-void StringName::set_source(const String &p_src)
-{
-	src = p_src;
-	update_hash();
-}
-String StringName::get_source() const
+StringName::StringName(const String &p_src)
 {
-	return src;
+	entry = intern(p_src);
 }
 
-bool StringName::operator==(const StringName &r) const
+//entries are never removed, a reader can walk a bucket while another thread adds to it
+const StringName::Entry* StringName::intern(const String &p_src)
 {
-	return hash == r.hash;
+	size_t hash = p_src.get_hash();
+	std::atomic<Entry*> &bucket = buckets[hash & (STRINGNAME_BUCKETS - 1)];
+
+	Entry *head = bucket.load(std::memory_order_acquire);
+	Entry *searched = NULL;
+	Entry *created = NULL;
+
+	while (true)
+	{
+		//only the entries in front of the searched ones are new
+		for (Entry *e = head; e != searched; e = e->next)
+		{
+			if (e->hash == hash && e->src == p_src)
+			{
+				delete created;
+				return e;
+			}
+		}
+
+		if (!created)
+			created = new Entry{ p_src, hash, NULL };
+
+		created->next = head;
+		searched = head;
+
+		//on failure head is the entry another thread added
+		if (bucket.compare_exchange_weak(head, created, std::memory_order_release, std::memory_order_acquire))
+			return created;
+	}
 }
 
 /*
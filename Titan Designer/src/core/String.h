@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "Vector.h"
@@ -18,6 +19,7 @@ public:
 	String(char v);
 	String(char *v);
 	String(const char *v);
+	String(const char *v, int length);
 	String(std::string v);
 	String(Char v);
 	String(const Real &r);
@@ -33,7 +35,7 @@ public:
 	//bool operator==(const string &r) const;
 	bool operator!=(const String & r) const;
 
-	bool operator<(const String &r) const { return get_hash() < r.get_hash(); }
+	bool operator<(const String &r) const { return src < r.src; }
 
 	friend std::ostream& operator<<(std::ostream &p_stream, const String &p_str);
 	friend String operator+(std::string &p_l, const String &p_r);
@@ -117,30 +119,42 @@ private:
 	std::string src;
 };
 
+//A name from a global intern table. Every text has one entry that keeps the text and
+//its hash, a StringName only points to it, so copies are free and two names are equal
+//when they point to the same entry. Any thread can intern names
 class StringName
 {
 public:
-	StringName() : StringName(String("")) { }
+	StringName();
 	StringName(const String &p_src);
 	StringName(const char *p_src) : StringName(String(p_src)) { }
 
-	void update_hash();
-
-	size_t get_hash() const;
-
-	void set_source(const String &p_src);
-	String get_source() const;
+	size_t get_hash() const { return entry->hash; }
+	const String& get_source() const { return entry->src; }
 
 	//the magic
-	bool operator==(const StringName &r) const;
-	//operator String() const;
+	bool operator==(const StringName &r) const { return entry == r.entry; }
+	bool operator!=(const StringName &r) const { return entry != r.entry; }
 
-	operator size_t() const { return hash; }
-	operator String() const { return src; }
-	operator std::string() const { return src; }
+	//orders by entry, not alphabetically
+	bool operator<(const StringName &r) const { return entry < r.entry; }
 
-	size_t hash;
+	operator size_t() const { return entry->hash; }
+	operator String() const { return entry->src; }
+	operator std::string() const { return entry->src; }
 
 private:
-	String src;
+	struct Entry
+	{
+		String src;
+		size_t hash;
+		Entry *next;
+	};
+
+	static const Entry* intern(const String &p_src);
+
+	//entries are only ever added to the front of a bucket, with a compare and swap
+	static std::atomic<Entry*> buckets[];
+
+	const Entry *entry;
 };
\ No newline at end of file
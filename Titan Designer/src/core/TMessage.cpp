@@ -1,126 +1,214 @@
 #include "TMessage.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 #include "types/Scriptable.h"
 
+//milliseconds the writer sleeps when the queue is empty
+#define WRITER_INTERVAL 10
+
 MessageHandler* MessageHandler::singleton;
 
 //=========================================================================
-//TMessage
+//MessageHandler
 //=========================================================================
 
-TMessage::TMessage(const String &p_description, const String &p_file_name, int p_line_number)
+MessageHandler::MessageHandler()
 {
-	description = p_description;
-	file_name = p_file_name;
-	line_number = p_line_number;
+	for (unsigned c = 0; c < MESSAGE_QUEUE_SIZE; c++)
+		queue[c].sequence = c;
+
+	push_position = 0;
+	pop_position = 0;
+	dropped = 0;
+
+	message_count = 0;
+	history.resize(MESSAGE_HISTORY_SIZE);
+
+	signal = NULL;
+	writer = NULL;
+	running = false;
 }
 
-void TMessage::log()
+void MessageHandler::log(TMessage::Type p_type, const String &p_description, const char *p_file_name, int p_line_number)
 {
-	ERROR_HANDLER->Log(this);
-}
+	if (!singleton)
+		return;
 
-//=========================================================================
-//TError
-//=========================================================================
+	if (!singleton->push(p_type, p_description, p_file_name, p_line_number))
+		singleton->dropped++;
+}
 
-TError::TError(const String &p_description, const String &p_file_name, int p_line_number) : TMessage(p_description, p_file_name, p_line_number)
+//a producer claims a slot by moving push_position past it, the slot is handed to the
+//writer by its sequence, so producers never wait for each other or for the writer
+bool MessageHandler::push(TMessage::Type p_type, const String &p_description, const char *p_file_name, int p_line_number)
 {
-	type = T_ERROR;
-	log();
-}
+	unsigned position = push_position.load(std::memory_order_relaxed);
+	Record *record;
 
-//=========================================================================
-//TWarning
-//=========================================================================
+	while (true)
+	{
+		record = &queue[position & (MESSAGE_QUEUE_SIZE - 1)];
+		int difference = static_cast<int>(record->sequence.load(std::memory_order_acquire) - position);
 
-TWarning::TWarning(const String &p_description, const String &p_file_name, int p_line_number) : TMessage(p_description, p_file_name, p_line_number)
-{
-	type = T_WARNING;
-	log();
-}
+		if (difference == 0)
+		{
+			if (push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)					//the writer did not read this slot yet
+			return false;
+		else
+			position = push_position.load(std::memory_order_relaxed);
+	}
 
-//=========================================================================
-//TLog
-//=========================================================================
+	int length = std::min(p_description.length(), MESSAGE_LENGTH - 1);
 
-TLog::TLog(const String &p_description, const String &p_file_name, int p_line_number) : TMessage(p_description, p_file_name, p_line_number)
-{
-	type = T_LOG;
-	log();
-}
+	record->type = p_type;
+	record->file_name = p_file_name;
+	record->line_number = p_line_number;
+	std::memcpy(record->description, p_description.c_str(), length);
+	record->description[length] = '\0';
 
-//=========================================================================
-//TInfo
-//=========================================================================
+	record->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
 
-TInfo::TInfo(const String &p_description, const String &p_file_name, int p_line_number) : TMessage(p_description, p_file_name, p_line_number)
+//returns false when the queue was empty
+bool MessageHandler::write_queued()
 {
-	type = T_INFO;
-	log();
-}
+	String output;
+	bool found = false;
 
-//=========================================================================
-//ErrorHandler
-//=========================================================================
+	while (true)
+	{
+		Record &record = queue[pop_position & (MESSAGE_QUEUE_SIZE - 1)];
+
+		if (record.sequence.load(std::memory_order_acquire) != pop_position + 1)
+			break;
+
+		add(record, output);
+		found = true;
+
+		//free for the next lap
+		record.sequence.store(pop_position + MESSAGE_QUEUE_SIZE, std::memory_order_release);
+		pop_position++;
+	}
+
+	int lost = dropped.exchange(0);
 
-void MessageHandler::Log(TMessage *msg)
+	if (lost)
+		output += "WARNING: " + String(lost) + " messages dropped, the log queue was full\n";
+
+	if (output.size())
+	{
+		std::cout << output << std::flush;
+
+		if (file.is_open())
+			file << output << std::flush;
+	}
+
+	return found;
+}
+
+//repeated messages are only counted
+void MessageHandler::add(const Record &p_record, String &r_output)
 {
-	for (int c = 0; c < messages.size(); c++)
+	String description = p_record.description;
+
+	std::lock_guard<std::mutex> lock(history_mutex);
+
+	if (int *id = message_ids.find(description))
 	{
-		if (messages[c]->description == msg->description)
-		{
-			messages[c]->count++;
-			return;
-		}
+		history[*id % MESSAGE_HISTORY_SIZE].count++;
+		return;
 	}
-	messages.push_back(msg);
 
-	emit(messages.size() - 1);
+	TMessage &message = history[message_count % MESSAGE_HISTORY_SIZE];
+
+	//the history is full, the oldest message is forgotten
+	if (message_count >= MESSAGE_HISTORY_SIZE)
+		message_ids.clear(message.description);
+
+	message.type = p_record.type;
+	message.description = description;
+	message.file_name = p_record.file_name;
+	message.line_number = p_record.line_number;
+	message.count = 1;
+
+	message_ids.set(description, message_count);
+	logged.push_back(message_count);
+	message_count++;
+
+	if (filters[message.type])
+		format(message, r_output);
+}
 
-	if (!filters[msg->type])
+void MessageHandler::format(const TMessage &p_message, String &r_output) const
+{
+	switch (p_message.type)
+	{
+	case TMessage::T_ERROR:
+		r_output += "ERROR: ";
+		break;
+	case TMessage::T_WARNING:
+		r_output += "WARNING: ";
+		break;
+	case TMessage::T_INFO:
+		r_output += "INFO: ";
+		break;
+	case TMessage::T_LOG:
+		r_output += "LOG: ";
+		break;
+	default:
 		return;
+	}
+
+	r_output += p_message.description;
 
 	if (complete_description)
+		r_output += ", file: " + p_message.file_name + ", line: " + String(p_message.line_number);
+
+	r_output += '\n';
+}
+
+void MessageHandler::run_writer()
+{
+	while (running)
 	{
-		switch (msg->type)
-		{
-		case TMessage::T_ERROR:
-			std::cout << "ERROR: " << msg->description << ", file: " << msg->file_name << ", line: " << msg->line_number << std::endl;
-			break;
-		case TMessage::T_WARNING:
-			std::cout << "WARNING: " << msg->description << ", file: " << msg->file_name << ", line: " << msg->line_number << std::endl;
-			break;
-		case TMessage::T_INFO:
-			std::cout << "INFO: " << msg->description << ", file: " << msg->file_name << ", line: " << msg->line_number << std::endl;
-			break;
-		case TMessage::T_LOG:
-			std::cout << "LOG: " << msg->description << ", file: " << msg->file_name << ", line: " << msg->line_number << std::endl;
-			break;
-		}
+		if (!write_queued())
+			std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_INTERVAL));
 	}
-	else
+
+	write_queued();
+}
+
+void MessageHandler::update()
+{
+	Array<int> ids;
 	{
-		switch (msg->type)
-		{
-		case TMessage::T_ERROR:
-			std::cout << "ERROR: " << msg->description << std::endl;
-			break;
-		case TMessage::T_WARNING:
-			std::cout << "WARNING: " << msg->description << std::endl;
-			break;
-		case TMessage::T_INFO:
-			std::cout << "INFO: " << msg->description << std::endl;
-			break;
-		case TMessage::T_LOG:
-			std::cout << "LOG: " << msg->description << std::endl;
-			break;
-		}
+		std::lock_guard<std::mutex> lock(history_mutex);
+		std::swap(ids, logged);
 	}
+
+	for (int id : ids)
+		emit(id);
 }
+
 void MessageHandler::clean()
 {
-	messages.clean();
+	if (!writer)
+		return;
+
+	running = false;
+	writer->join();
+
+	delete writer;
+	writer = NULL;
+
+	file.close();
 }
 
 void MessageHandler::init()
@@ -132,6 +220,11 @@ void MessageHandler::init()
 	singleton->filters.push_back(true);	//WARNING
 	singleton->filters.push_back(true);	//LOG
 	singleton->filters.push_back(true);	//INFO
+
+	singleton->file.open("log.txt", std::ios::out | std::ios::trunc);
+
+	singleton->running = true;
+	singleton->writer = new std::thread(&MessageHandler::run_writer, singleton);
 }
 
 
@@ -142,34 +235,21 @@ void MessageHandler::bind_methods()
 	//REG_SIGNAL("logged");
 }
 
-TMessage* MessageHandler::get_message(int p_index) const
+TMessage MessageHandler::get_message(int p_index)
 {
-	return messages[p_index];
-}
+	std::lock_guard<std::mutex> lock(history_mutex);
 
+	if (p_index < 0 || p_index >= message_count || message_count - p_index > MESSAGE_HISTORY_SIZE)
+		return TMessage();
+
+	return history[p_index % MESSAGE_HISTORY_SIZE];
+}
 void MessageHandler::emit(int p_index)
 {
 	if (!signal)
 		return;
 
-	for (Connection &connection : signal->connections)
-	{
-		Connection* c = const_cast<Connection*>(&connection);
-
-		if (!connection.method)
-			return;
-
-		if (connection.type == Connection::NATIVE)
-		{
-			if (connection.method->arg_count == 2)
-			{
-				V_Method_2* m = reinterpret_cast<V_Method_2*>(connection.method);
-				m->operator() (connection.object, p_index);
-			}
-		}
-		else if (connection.type == Connection::TITANSCRIPT)
-			connection.scriptable->run(connection.name, Arguments(p_index));
-	}
+	signal->emit(p_index);
 }
 
 
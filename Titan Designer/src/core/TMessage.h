@@ -1,18 +1,32 @@
 #pragma once
 
+#include <atomic>
 #include <iostream>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 #include "String.h"
 #include "Vector.h"
 #include "Array.h"
+#include "HashMap.h"
 
-#define T_ERROR(X) new TError(X, __FILE__, __LINE__)
-#define T_WARNING(X) new TWarning(X, __FILE__, __LINE__)
-#define T_LOG(X) new TLog(X, __FILE__, __LINE__)
-#define T_INFO(X) new TInfo(X, __FILE__, __LINE__)
+#define T_ERROR(X) MessageHandler::log(TMessage::T_ERROR, X, __FILE__, __LINE__)
+#define T_WARNING(X) MessageHandler::log(TMessage::T_WARNING, X, __FILE__, __LINE__)
+#define T_LOG(X) MessageHandler::log(TMessage::T_LOG, X, __FILE__, __LINE__)
+#define T_INFO(X) MessageHandler::log(TMessage::T_INFO, X, __FILE__, __LINE__)
 
 #define ERROR_HANDLER MessageHandler::get_singleton()
 
+//capacity of the queue between the threads that log and the writer, a power of two
+#define MESSAGE_QUEUE_SIZE 1024
+
+//longer descriptions are cut off
+#define MESSAGE_LENGTH 256
+
+//the unique messages that are kept, older ones are forgotten
+#define MESSAGE_HISTORY_SIZE 1024
+
 struct TMessage
 {
 	enum Type
@@ -24,48 +38,35 @@ struct TMessage
 		T_INFO
 	};
 
-	Type type;
+	Type type = UNDEF;
 	String description;
 	String file_name;
-	int line_number;
-	int count;
-
-	TMessage(const String &p_description, const String &p_file_name, int p_line_number);
-
-protected:
-	void log();
-};
-
-struct TError : TMessage
-{
-	TError(const String &p_description, const String &p_file_name, int p_line_number);
-};
-
-struct TWarning : TMessage
-{
-	TWarning(const String &p_description, const String &p_file_name, int p_line_number);
-};
-
-struct TLog : TMessage
-{
-	TLog(const String &p_description, const String &p_file_name, int p_line_number);
-};
-
-struct TInfo : TMessage
-{
-	TInfo(const String &p_description, const String &p_file_name, int p_line_number);
+	int line_number = 0;
+	int count = 0;
 };
 
 class Object;
 class Signal;
 
+//Messages are logged without a lock or an allocation: the text is copied into a slot of
+//a fixed size queue, any thread can add to it. A writer thread takes them out, counts
+//the repeated ones and writes the new ones in batches to the console and the log file.
+//When the queue is full messages are dropped and counted, the writer reports them
 class MessageHandler
 {
 public:
-	void Log(TMessage *msg);
+	MessageHandler();
+
+	static void log(TMessage::Type p_type, const String &p_description, const char *p_file_name, int p_line_number);
+
+	//emits logged for the messages the writer added since the last call, on the main thread
+	void update();
+
+	//writes the remaining messages and stops the writer
 	void clean();
 
-	TMessage* get_message(int p_index) const;
+	//a copy, the writer can reuse the slot; of type UNDEF when the message is forgotten already
+	TMessage get_message(int p_index);
 
 	void emit(int p_index);
 
@@ -77,11 +78,42 @@ public:
 	static void bind_methods();
 
 private:
+	struct Record
+	{
+		std::atomic<unsigned> sequence;			//tells which lap of the queue may use the slot
+		TMessage::Type type;
+		const char *file_name;
+		int line_number;
+		char description[MESSAGE_LENGTH];
+	};
+
+	bool push(TMessage::Type p_type, const String &p_description, const char *p_file_name, int p_line_number);
+	bool write_queued();
+	void add(const Record &p_record, String &r_output);
+	void format(const TMessage &p_message, String &r_output) const;
+
+	void run_writer();
+
+	Record queue[MESSAGE_QUEUE_SIZE];
+	std::atomic<unsigned> push_position;
+	unsigned pop_position;
+	std::atomic<int> dropped;
+
+	std::thread *writer;
+	std::atomic<bool> running;
+	std::ofstream file;
+
+	//written by the writer, read by the main thread
+	std::mutex history_mutex;
+	Array<TMessage> history;
+	HashMap<String, int> message_ids;
+	int message_count;
+	Array<int> logged;
+
 	Signal* signal;
 
-	Vector<TMessage> messages;
 	Array<char> filters;
 	bool complete_description = false;
 
 	static MessageHandler *singleton;
-};
\ No newline at end of file
+};
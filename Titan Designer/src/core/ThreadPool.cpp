@@ -0,0 +1,162 @@
+#include "ThreadPool.h"
+
+ThreadPool *ThreadPool::singleton;
+
+ThreadPool::ThreadPool(int p_thread_count)
+{
+	job = NULL;
+	generation = 0;
+	active_workers = 0;
+	remaining = 0;
+	quitting = false;
+
+	for (int c = 0; c < p_thread_count + 1; c++)
+		queues.push_back(new WorkQueue);
+
+	for (int c = 0; c < p_thread_count; c++)
+		threads.push_back(new std::thread(&ThreadPool::thread_main, this, c + 1));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quitting = true;
+	}
+	start_condition.notify_all();
+
+	for (int c = 0; c < threads.size(); c++)
+	{
+		threads[c]->join();
+		delete threads[c];
+	}
+
+	for (int c = 0; c < queues.size(); c++)
+		delete queues[c];
+}
+
+void ThreadPool::Init()
+{
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+	singleton = new ThreadPool(hardware > 1 ? hardware - 1 : 0);
+}
+
+ThreadPool* ThreadPool::get_singleton()
+{
+	return singleton;
+}
+
+void ThreadPool::run_batch(int p_task_count, const Job &p_job)
+{
+	if (p_task_count == 0)
+		return;
+
+	int worker_count = get_worker_count();
+
+	//set before any task is visible, a worker that woke up late for the last batch may already be looking
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &p_job;
+		remaining = p_task_count;
+	}
+
+	//contiguous ranges keep neighbouring tasks on the same worker
+	for (int c = 0; c < worker_count; c++)
+	{
+		std::lock_guard<std::mutex> lock(queues[c]->mutex);
+
+		for (int i = c * p_task_count / worker_count; i < (c + 1) * p_task_count / worker_count; i++)
+			queues[c]->tasks.push_back(i);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		generation++;
+	}
+	start_condition.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this]() { return remaining == 0 && active_workers == 0; });
+}
+
+int ThreadPool::get_worker_count() const
+{
+	return threads.size() + 1;
+}
+
+void ThreadPool::thread_main(int p_worker)
+{
+	int seen_generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			start_condition.wait(lock, [&]() { return quitting || generation != seen_generation; });
+
+			if (quitting)
+				return;
+
+			seen_generation = generation;
+			active_workers++;
+		}
+
+		work(p_worker);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			active_workers--;
+		}
+		done_condition.notify_all();
+	}
+}
+
+void ThreadPool::work(int p_worker)
+{
+	int task;
+
+	while (pop(p_worker, task) || steal(p_worker, task))
+	{
+		(*job)(task, p_worker);
+
+		if (--remaining == 0)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done_condition.notify_all();
+		}
+	}
+}
+
+bool ThreadPool::pop(int p_worker, int &r_task)
+{
+	WorkQueue *queue = queues[p_worker];
+	std::lock_guard<std::mutex> lock(queue->mutex);
+
+	if (queue->tasks.empty())
+		return false;
+
+	r_task = queue->tasks.back();
+	queue->tasks.pop_back();
+	return true;
+}
+
+bool ThreadPool::steal(int p_worker, int &r_task)
+{
+	for (int c = 1; c < queues.size(); c++)
+	{
+		WorkQueue *queue = queues[(p_worker + c) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+
+		if (queue->tasks.empty())
+			continue;
+
+		r_task = queue->tasks.front();
+		queue->tasks.pop_front();
+		return true;
+	}
+
+	return false;
+}
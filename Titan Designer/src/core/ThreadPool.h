@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Array.h"
+
+#define THREADPOOL ThreadPool::get_singleton()
+
+//Worker threads for batches of independent tasks. The tasks of a batch are split over
+//the workers up front, a worker that runs out of its own tasks steals from the others.
+class ThreadPool
+{
+public:
+	typedef std::function<void(int p_task, int p_worker)> Job;
+
+	ThreadPool(int p_thread_count);
+	~ThreadPool();
+
+	static void Init();
+	static ThreadPool* get_singleton();
+
+	//runs p_job for every task in [0, p_task_count) and returns once all of them are done,
+	//the calling thread works along as worker 0
+	void run_batch(int p_task_count, const Job &p_job);
+
+	int get_worker_count() const;
+
+private:
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<int> tasks;
+	};
+
+	void thread_main(int p_worker);
+	void work(int p_worker);
+
+	//the owner takes from the back, thieves from the front
+	bool pop(int p_worker, int &r_task);
+	bool steal(int p_worker, int &r_task);
+
+	Array<std::thread*> threads;
+	Array<WorkQueue*> queues;
+
+	std::mutex mutex;
+	std::condition_variable start_condition, done_condition;
+
+	const Job *job;
+	int generation;
+	int active_workers;
+	std::atomic<int> remaining;
+	bool quitting;
+
+	static ThreadPool *singleton;
+};
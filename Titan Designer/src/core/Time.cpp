@@ -1,5 +1,6 @@
 #include "Time.h"
 #include "ui/UICallback.h"
+#include "core/titanscript/ScriptScheduler.h"
 
 Time *Time::singleton;
 
@@ -62,6 +63,8 @@ void Time::OnUpdate()
 
 	for (int c = 0; c < uitimers.size(); c++)
 		uitimers[c]->update();
+
+	SCHEDULER->update();
 }
 
 void Time::restart()
@@ -3,15 +3,19 @@
 #include <vector>
 #include <algorithm>
 
-template<class VAL> class Vector
+template<class VAL, class ALLOC = std::allocator<VAL*>> class Vector
 {
 private:
-	typedef std::vector<VAL*> V;
+	typedef std::vector<VAL*, ALLOC> V;
 	V vec;
 
 public:
 	Vector() { }
-	Vector(V v) { vec = v; }
+	Vector(V v) : vec(std::move(v)) { }
+
+	//copies the pointers of a Vector that uses another allocator
+	template<class OTHER>
+	Vector(const Vector<VAL, OTHER> &p_vector) : vec(p_vector.begin(), p_vector.end()) { }
 	
 	//Constructor function
 	void buildarray(VAL** arr, int size)
@@ -89,7 +93,7 @@ public:
 	}
 
 	//Helper
-	bool contains(VAL v) const
+	bool contains(const VAL &v) const
 	{
 		for (VAL *e : vec)
 			if (v == *e)
@@ -105,15 +109,15 @@ public:
 
 		return false;
 	}
-	Vector<VAL> split(int start, int end) const
+	Vector split(int start, int end) const
 	{
-		Vector<VAL> result;
+		Vector result;
 		for (int c = start; c <= end; c++)
 			result.push_back(vec[c]);
 
 		return result;
 	}
-	Vector<VAL> getrest(int start) const
+	Vector getrest(int start) const
 	{
 		return split(start, size() - 1);
 	}
@@ -128,7 +132,7 @@ public:
 		vec.push_back(e);
 		return *this;
 	}
-	bool operator==(Vector v) const
+	bool operator==(const Vector &v) const
 	{
 		if (size() != v.size())
 			return false;
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "core/Array.h"
+#include "core/variant/Variant.h"
+#include "ScriptNode.h"
+
+class Function;
+
+//Opcodes of the register based TitanScript VM
+//a, b and c are register indices unless noted otherwise
+enum OpCode
+{
+	OP_LOAD_NULL,		//r[a] = NULL
+	OP_LOAD_BOOL,		//r[a] = (bool) b
+	OP_LOAD_INT,		//r[a] = (short) b
+	OP_LOAD_CONST,		//r[a] = constants[b].copy()
+	OP_MOVE,			//r[a] = r[b]
+
+	OP_GET_VAR,			//r[a] = global names[b]
+	OP_SET_VAR,			//global names[b] = r[a]
+	OP_GET_SUPER,		//r[a] = extension.(SuperVariable) nodes[b]
+	OP_SET_SUPER,		//extension.(SuperVariable) nodes[b] = r[a]
+	OP_GET_MEMBER,		//r[a] = r[b].(MemberVar) nodes[c]
+	OP_SET_MEMBER,		//r[a].(MemberVar) nodes[c] = r[b]
+	OP_GET_SELF,		//r[a] = extension
+
+	OP_ADD,				//r[a] = r[b] + r[c]
+	OP_SUBTRACT,		//r[a] = r[b] - r[c]
+	OP_MULTIPLY,		//r[a] = r[b] * r[c]
+	OP_DIVIDE,			//r[a] = r[b] / r[c]
+
+	OP_LESS,			//r[a] = r[b] < r[c]
+	OP_GREATER,			//r[a] = r[b] > r[c]
+	OP_LEQUAL,			//r[a] = r[b] <= r[c]
+	OP_GEQUAL,			//r[a] = r[b] >= r[c]
+	OP_EQUAL,			//r[a] = r[b] == r[c]
+	OP_NOTEQUAL,		//r[a] = r[b] != r[c]
+
+	OP_NOT,				//r[a] = !r[b]
+	OP_NEGATE,			//r[a] = -r[b]
+
+	//typed arithmetic and comparisons, emitted when the TypeInference proved the operand types.
+	//Every group follows the order of the generic opcodes, the Compiler selects them by offset
+	OP_ADD_INT,			//r[a] = r[b].i + r[c].i
+	OP_SUBTRACT_INT,
+	OP_MULTIPLY_INT,
+	OP_DIVIDE_INT,
+
+	OP_ADD_FLOAT,		//r[a] = r[b].f + r[c].f
+	OP_SUBTRACT_FLOAT,
+	OP_MULTIPLY_FLOAT,
+	OP_DIVIDE_FLOAT,
+
+	OP_ADD_VEC2,		//r[a] = r[b].v2 + r[c].v2
+	OP_SUBTRACT_VEC2,
+	OP_MULTIPLY_VEC2,
+	OP_DIVIDE_VEC2,
+	OP_ADD_VEC3,
+	OP_SUBTRACT_VEC3,
+	OP_MULTIPLY_VEC3,
+	OP_DIVIDE_VEC3,
+	OP_ADD_VEC4,
+	OP_SUBTRACT_VEC4,
+	OP_MULTIPLY_VEC4,
+	OP_DIVIDE_VEC4,
+
+	OP_ADD_VEC2_FLOAT,	//r[a] = r[b].v2 + r[c].f
+	OP_SUBTRACT_VEC2_FLOAT,
+	OP_MULTIPLY_VEC2_FLOAT,
+	OP_DIVIDE_VEC2_FLOAT,
+	OP_ADD_VEC3_FLOAT,
+	OP_SUBTRACT_VEC3_FLOAT,
+	OP_MULTIPLY_VEC3_FLOAT,
+	OP_DIVIDE_VEC3_FLOAT,
+	OP_ADD_VEC4_FLOAT,
+	OP_SUBTRACT_VEC4_FLOAT,
+	OP_MULTIPLY_VEC4_FLOAT,
+	OP_DIVIDE_VEC4_FLOAT,
+
+	OP_LESS_INT,		//r[a] = r[b].i < r[c].i
+	OP_GREATER_INT,
+	OP_LEQUAL_INT,
+	OP_GEQUAL_INT,
+
+	OP_LESS_FLOAT,		//r[a] = r[b].f < r[c].f
+	OP_GREATER_FLOAT,
+	OP_LEQUAL_FLOAT,
+	OP_GEQUAL_FLOAT,
+
+	OP_JUMP,			//pc = a
+	OP_JUMP_IF_FALSE,	//if !r[a]: pc = b
+	OP_JUMP_IF_TRUE,	//if r[a]: pc = b
+	OP_JUMP_IF_NOT_INLINE,	//if r[a] is not stored inline: pc = b
+	OP_JUMP_IF_CONST_CALL,	//if (MemberFunc) nodes[c] on r[a] does not change its receiver: pc = b
+
+	OP_ARRAY_PUSH,		//r[a].push_back(r[b])
+	OP_INDEX,			//r[a] = r[b][r[c]]
+	OP_COMPOSE,			//r[a] = { r[b] .. r[b + c - 1] }
+
+	OP_CONSTRUCT,		//r[a] = (Constructor) nodes[c] with arguments starting at r[b]
+	OP_SINGLETON,		//r[a] = singleton of (TypeSpecifier) nodes[b]
+	OP_CALL,			//r[a] = call_sites[c] with arguments starting at r[b]
+	OP_CALL_STATIC,		//r[a] = (StaticFuncCall) nodes[c] with arguments starting at r[b]
+	OP_CALL_SUPER,		//r[a] = (SuperFunction) nodes[c] with extension in r[b], arguments after it
+	OP_CALL_MEMBER,		//r[a] = (MemberFunc) nodes[c] with receiver in r[b], arguments after it
+
+	OP_YIELD,			//suspend until (Yield::WaitType) c with arguments starting at r[b], r[a] = value it resumes with
+
+	OP_RETURN,			//return r[a]
+	OP_RETURN_NULL		//return NULL
+};
+
+struct Instruction
+{
+	unsigned short op;
+	unsigned short a, b, c;
+};
+
+//call to a user-defined function, resolved at compile time when possible
+struct CallSite
+{
+	StringName name;
+	Function *target;
+	int arg_count;
+};
+
+struct CompiledFunction
+{
+	StringName name;
+
+	int param_count = 0;
+	int slot_count = 0;		//parameters and locals live in the first registers
+	int register_count = 0;
+
+	Array<StringName> params;
+	Array<Instruction> code;
+	Array<int> lines;		//source line of each instruction
+
+	Array<Variant> constants;
+	Array<StringName> names;
+	Array<ScriptNode*> nodes;
+	Array<CallSite> call_sites;
+};
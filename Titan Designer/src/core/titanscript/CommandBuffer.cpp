@@ -0,0 +1,167 @@
+#include "CommandBuffer.h"
+
+#include <algorithm>
+
+#include "core/Data.h"
+#include "types/Scriptable.h"
+#include "ScriptScheduler.h"
+
+thread_local CommandBuffer *CommandBuffer::current;
+
+CommandBuffer::CommandBuffer()
+{
+	task = 0;
+}
+
+CommandBuffer::Command& CommandBuffer::add(Command::Type p_type)
+{
+	Command command;
+	command.type = p_type;
+	command.task = task;
+	command.sequence = commands.size();
+	command.method = NULL;
+	command.source = NULL;
+	command.coroutine = NULL;
+	command.state = NULL;
+	command.wait = Yield::WAIT_FRAME;
+	command.arg_count = 0;
+	command.file_name = NULL;
+	command.line_number = 0;
+
+	commands.push_back(command);
+	return commands.getlast();
+}
+
+void CommandBuffer::call(Method *p_method, const Variant *p_args, int p_arg_count)
+{
+	if (p_arg_count > MAX_METHOD_ARGS)
+	{
+		SCRIPT_ERROR("Too many arguments for method: " + p_method->name.get_source());
+		return;
+	}
+
+	Command &command = add(Command::CALL);
+	command.method = p_method;
+	command.arg_count = p_arg_count;
+
+	for (int c = 0; c < p_arg_count; c++)
+		command.args[c] = p_args[c];
+}
+
+void CommandBuffer::emit(Scriptable *p_source, const StringName &p_signal)
+{
+	Command &command = add(Command::EMIT);
+	command.source = p_source;
+	command.signal = p_signal;
+}
+
+void CommandBuffer::emit(Scriptable *p_source, const StringName &p_signal, const Variant &p_arg)
+{
+	Command &command = add(Command::EMIT);
+	command.source = p_source;
+	command.signal = p_signal;
+	command.args[0] = p_arg;
+	command.arg_count = 1;
+}
+
+void CommandBuffer::park(Coroutine *p_coroutine, Yield::WaitType p_wait, const Variant *p_args)
+{
+	Command &command = add(Command::PARK);
+	command.coroutine = p_coroutine;
+	command.wait = p_wait;
+	command.arg_count = p_wait == Yield::WAIT_SECONDS ? 1 : p_wait == Yield::WAIT_SIGNAL ? 2 : 0;
+
+	for (int c = 0; c < command.arg_count; c++)
+		command.args[c] = p_args[c];
+}
+
+void CommandBuffer::set_var(State *p_state, const StringName &p_name, const Variant &p_value)
+{
+	Command &command = add(Command::SET_VAR);
+	command.state = p_state;
+	command.name = p_name;
+	command.args[0] = p_value;
+	command.arg_count = 1;
+}
+
+void CommandBuffer::error(const String &p_description, const char *p_file_name, int p_line_number)
+{
+	Command &command = add(Command::REPORT);
+	command.description = p_description;
+	command.file_name = p_file_name;
+	command.line_number = p_line_number;
+}
+
+void CommandBuffer::report(const String &p_description, const char *p_file_name, int p_line_number)
+{
+	if (current)
+		current->error(p_description, p_file_name, p_line_number);
+	else
+		MessageHandler::log(TMessage::T_ERROR, p_description, p_file_name, p_line_number);
+}
+
+void CommandBuffer::forget(Scriptable *p_source)
+{
+	for (int c = 0; c < commands.size(); c++)
+		if (commands[c].type == Command::EMIT && commands[c].source == p_source)
+			commands[c].source = NULL;
+}
+
+void CommandBuffer::clear()
+{
+	commands.clear();
+}
+
+void CommandBuffer::apply(const Array<CommandBuffer*> &p_buffers)
+{
+	Array<const Command*> ordered;
+
+	for (int c = 0; c < p_buffers.size(); c++)
+		for (int i = 0; i < p_buffers[c]->commands.size(); i++)
+			ordered.push_back(&p_buffers[c]->commands[i]);
+
+	std::sort(ordered.begin(), ordered.end(), [](const Command *l, const Command *r)
+	{
+		return l->task != r->task ? l->task < r->task : l->sequence < r->sequence;
+	});
+
+	for (int c = 0; c < ordered.size(); c++)
+	{
+		const Command *command = ordered[c];
+
+		switch (command->type)
+		{
+		case Command::CALL:
+		{
+			Variant result;
+			command->method->call(command->args, result);
+			break;
+		}
+
+		case Command::EMIT:
+			if (!command->source)
+				break;
+
+			if (command->arg_count == 0)
+				command->source->emit_signal(command->signal);
+			else
+				command->source->emit_signal(command->signal, command->args[0]);
+			break;
+
+		case Command::PARK:
+			SCHEDULER->park(command->coroutine, command->wait, command->args);
+			break;
+
+		case Command::SET_VAR:
+			command->state->SetVar(command->name, command->args[0]);
+			break;
+
+		case Command::REPORT:
+			MessageHandler::log(TMessage::T_ERROR, command->description, command->file_name, command->line_number);
+			break;
+		}
+	}
+
+	for (int c = 0; c < p_buffers.size(); c++)
+		p_buffers[c]->clear();
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "core/Array.h"
+#include "Bytecode.h"
+
+class Scriptable;
+class State;
+struct Coroutine;
+
+//T_ERROR for code that can run in a parallel update, the error is logged when the buffer is applied
+#define SCRIPT_ERROR(X) CommandBuffer::report(X, __FILE__, __LINE__)
+
+//Side effects of a script that runs in a parallel update. Each worker records into its
+//own buffer while CommandBuffer::current points at it, the buffers are applied on the
+//main thread after the batch, in update order no matter which worker ran what.
+class CommandBuffer
+{
+public:
+	CommandBuffer();
+
+	//non-const method on another object, property setters included
+	void call(Method *p_method, const Variant *p_args, int p_arg_count);
+	void emit(Scriptable *p_source, const StringName &p_signal);
+	void emit(Scriptable *p_source, const StringName &p_signal, const Variant &p_arg);
+	void park(Coroutine *p_coroutine, Yield::WaitType p_wait, const Variant *p_args);
+
+	//a global of a script whose State is shared by several objects in the batch
+	void set_var(State *p_state, const StringName &p_name, const Variant &p_value);
+
+	void error(const String &p_description, const char *p_file_name, int p_line_number);
+
+	//records the error in the buffer of the calling thread, logs it right away outside a parallel update
+	static void report(const String &p_description, const char *p_file_name, int p_line_number);
+
+	//drops the signals of an object that is deleted before the buffer is applied
+	void forget(Scriptable *p_source);
+
+	void clear();
+	int size() const { return commands.size(); }
+
+	//applies the commands ordered on task first, then on the order they were recorded in
+	static void apply(const Array<CommandBuffer*> &p_buffers);
+
+	//index of the running task in the batch
+	int task;
+
+	//the buffer of the calling thread, NULL outside a parallel update
+	static thread_local CommandBuffer *current;
+
+private:
+	struct Command
+	{
+		enum Type
+		{
+			CALL,
+			EMIT,
+			PARK,
+			SET_VAR,
+			REPORT
+		};
+
+		Type type;
+		int task;
+		int sequence;
+
+		Method *method;
+		Scriptable *source;
+		StringName signal;
+		Coroutine *coroutine;
+		Yield::WaitType wait;
+
+		State *state;
+		StringName name;
+
+		Variant args[MAX_METHOD_ARGS];
+		int arg_count;
+
+		String description;
+		const char *file_name;
+		int line_number;
+	};
+
+	Command& add(Command::Type p_type);
+
+	Array<Command> commands;
+};
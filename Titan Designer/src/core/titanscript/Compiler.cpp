@@ -0,0 +1,774 @@
+#include "Compiler.h"
+
+#include "core/TMessage.h"
+#include "TypeInference.h"
+
+Compiler::Compiler(State *p_state)
+{
+	state = p_state;
+	function = NULL;
+	next_register = 0;
+	line = 0;
+}
+
+void Compiler::compile_all(const Line &p_root)
+{
+	for (int c = 0; c < p_root.sub.size(); c++)
+	{
+		ScriptNode *node = p_root.sub[c]->node;
+
+		if (!node || node->type != ScriptNode::FUNCTIONINIT)
+			continue;
+
+		FunctionInit *init = reinterpret_cast<FunctionInit*>(node);
+
+		if (state->FuncExists(init->name))
+			compile(state->GetFunc(init->name));
+	}
+}
+
+CompiledFunction* Compiler::compile(Function *p_function)
+{
+	Block *block = p_function->block;
+
+	function = new CompiledFunction;
+	function->name = p_function->name;
+	function->param_count = block->params.size();
+
+	for (int c = 0; c < block->params.size(); c++)
+		function->params.push_back(reinterpret_cast<VariableNode*>(block->params[c])->name);
+
+	//the arguments and locals occupy the first registers of the frame
+	function->slot_count = block->slot_count;
+	next_register = function->slot_count;
+	function->register_count = next_register;
+	line = 0;
+
+	TypeInference().infer(block);
+	compile_block(block);
+	emit(OP_RETURN_NULL);
+
+	delete p_function->compiled;
+	p_function->compiled = function;
+
+	return function;
+}
+
+void Compiler::compile_block(Block *p_block)
+{
+	for (int c = 0; c < p_block->lines.size(); c++)
+		compile_statement(p_block->lines[c]);
+}
+
+void Compiler::compile_statement(ScriptNode *p_node)
+{
+	if (!p_node)											//else and elseif lines
+		return;
+
+	int top = next_register;
+	int previous_line = line;
+
+	if (p_node->line)
+		line = p_node->line;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::IF:
+		compile_if(reinterpret_cast<If*>(p_node));
+		break;
+
+	case ScriptNode::WHILE:
+		compile_while(reinterpret_cast<WhileLoop*>(p_node));
+		break;
+
+	case ScriptNode::FOR:
+		compile_for(reinterpret_cast<ForLoop*>(p_node));
+		break;
+
+	case ScriptNode::BLOCK:
+		compile_block(reinterpret_cast<Block*>(p_node));
+		break;
+
+	case ScriptNode::RETURN:
+	{
+		Return *re = reinterpret_cast<Return*>(p_node);
+
+		if (re->val)
+		{
+			int r = alloc_register();
+			compile_expression(re->val, r);
+			emit(OP_RETURN, r);
+		}
+		else
+			emit(OP_RETURN_NULL);
+		break;
+	}
+
+	case ScriptNode::EXTENDS:
+	case ScriptNode::FUNCTIONINIT:							//functions are only defined at the top level
+		break;
+
+	default:
+		compile_expression(p_node, alloc_register());
+		break;
+	}
+
+	free_registers(top);
+	line = previous_line;
+}
+
+void Compiler::compile_expression(ScriptNode *p_node, int p_dest)
+{
+	if (!p_node)
+	{
+		emit(OP_LOAD_NULL, p_dest);
+		return;
+	}
+
+	int top = next_register;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::CONSTANT:
+		emit(OP_LOAD_CONST, p_dest, add_constant(reinterpret_cast<Constant*>(p_node)->value));
+		break;
+
+	case ScriptNode::VARIABLE:
+	{
+		VariableNode *var = reinterpret_cast<VariableNode*>(p_node);
+
+		if (var->slot >= 0)
+			emit(OP_MOVE, p_dest, var->slot);
+		else
+			emit(OP_GET_VAR, p_dest, add_name(var->name));
+		break;
+	}
+
+	case ScriptNode::SUPERVAR:
+		emit(OP_GET_SUPER, p_dest, add_node(p_node));
+		break;
+
+	case ScriptNode::TYPE_SPECIFIER:
+		emit(OP_SINGLETON, p_dest, add_node(p_node));
+		break;
+
+	case ScriptNode::PARENTHESES:
+		compile_expression(reinterpret_cast<Parentheses*>(p_node)->node, p_dest);
+		break;
+
+	case ScriptNode::PATH:
+	{
+		Path *path = reinterpret_cast<Path*>(p_node);
+		compile_path(path, path->path.size(), p_dest);
+		break;
+	}
+
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		int right = alloc_register();
+
+		compile_expression(sum->left, p_dest);
+		compile_expression(sum->right, right);
+		emit(specialize(get_operation(sum->op), get_result_type(sum->left), get_result_type(sum->right)), p_dest, p_dest, right);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		int right = alloc_register();
+
+		compile_expression(pro->left, p_dest);
+		compile_expression(pro->right, right);
+		emit(specialize(get_operation(pro->op), get_result_type(pro->left), get_result_type(pro->right)), p_dest, p_dest, right);
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	{
+		Comparison *comp = reinterpret_cast<Comparison*>(p_node);
+		int right = alloc_register();
+
+		compile_expression(comp->left, p_dest);
+		compile_expression(comp->right, right);
+		emit(specialize(get_comparison(comp->eval), get_result_type(comp->left), get_result_type(comp->right)), p_dest, p_dest, right);
+		break;
+	}
+
+	case ScriptNode::AND:
+		compile_and(reinterpret_cast<And*>(p_node), p_dest);
+		break;
+
+	case ScriptNode::OR:
+		compile_or(reinterpret_cast<Or*>(p_node), p_dest);
+		break;
+
+	case ScriptNode::NOT:
+		compile_expression(reinterpret_cast<Not*>(p_node)->right, p_dest);
+		emit(OP_NOT, p_dest, p_dest);
+		break;
+
+	case ScriptNode::ORIENTATION:
+	{
+		Orientation *o = reinterpret_cast<Orientation*>(p_node);
+		compile_expression(o->right, p_dest);
+
+		if (o->negate)
+			emit(OP_NEGATE, p_dest, p_dest);
+		break;
+	}
+
+	case ScriptNode::INIT:
+	{
+		Init *init = reinterpret_cast<Init*>(p_node);
+		compile_expression(init->val, p_dest);
+		compile_store(init->var, p_dest);
+		break;
+	}
+
+	case ScriptNode::MODIFY:
+	{
+		Modify *mod = reinterpret_cast<Modify*>(p_node);
+		compile_modify(mod->var, mod->val, mod->op, p_dest);
+		break;
+	}
+
+	case ScriptNode::CHANGEONE:
+	{
+		ChangeOne *one = reinterpret_cast<ChangeOne*>(p_node);
+		compile_modify(one->var, NULL, one->op, p_dest);
+		break;
+	}
+
+	case ScriptNode::ARRAY_INIT:
+	{
+		ArrayInit *init = reinterpret_cast<ArrayInit*>(p_node);
+		int element = alloc_register();
+
+		emit(OP_LOAD_NULL, p_dest);
+
+		for (ScriptNode *n : init->nodes)
+		{
+			compile_expression(n, element);
+			emit(OP_ARRAY_PUSH, p_dest, element);
+		}
+		break;
+	}
+
+	case ScriptNode::ARRAY_INDEXING:
+	{
+		ArrayIndexing *indexing = reinterpret_cast<ArrayIndexing*>(p_node);
+		int index = alloc_register();
+
+		compile_expression(indexing->array, p_dest);
+		compile_expression(indexing->index, index);
+		emit(OP_INDEX, p_dest, p_dest, index);
+		break;
+	}
+
+	case ScriptNode::COMPOSITION:
+	{
+		Composition *comp = reinterpret_cast<Composition*>(p_node);
+		int base = alloc_register(comp->nodes.size());
+
+		compile_call_arguments(comp->nodes, base);
+		emit(OP_COMPOSE, p_dest, base, comp->nodes.size());
+		break;
+	}
+
+	case ScriptNode::CONSTRUCTOR:
+	{
+		Constructor *cstr = reinterpret_cast<Constructor*>(p_node);
+		int base = alloc_register(cstr->params.size());
+
+		compile_call_arguments(cstr->params, base);
+		emit(OP_CONSTRUCT, p_dest, base, add_node(p_node));
+		break;
+	}
+
+	case ScriptNode::FUNCTIONCALL:
+	{
+		FunctionCall *call = reinterpret_cast<FunctionCall*>(p_node);
+		int base = alloc_register(call->params.size());
+
+		compile_call_arguments(call->params, base);
+		emit(OP_CALL, p_dest, base, add_call_site(call));
+		break;
+	}
+
+	case ScriptNode::STATICFUNC:
+	{
+		StaticFuncCall *call = reinterpret_cast<StaticFuncCall*>(p_node);
+		int base = alloc_register(call->params.size());
+
+		compile_call_arguments(call->params, base);
+		emit(OP_CALL_STATIC, p_dest, base, add_node(p_node));
+		break;
+	}
+
+	case ScriptNode::SUPERFUNC:
+	{
+		SuperFunction *call = reinterpret_cast<SuperFunction*>(p_node);
+		int base = alloc_register(call->params.size() + 1);
+
+		emit(OP_GET_SELF, base);
+		compile_call_arguments(call->params, base + 1);
+		emit(OP_CALL_SUPER, p_dest, base, add_node(p_node));
+		break;
+	}
+
+	case ScriptNode::YIELD:
+	{
+		Yield *y = reinterpret_cast<Yield*>(p_node);
+		int base = alloc_register(y->params.size());
+
+		compile_call_arguments(y->params, base);
+		emit(OP_YIELD, p_dest, base, y->wait);
+		break;
+	}
+
+	default:
+		T_ERROR("Cannot compile statement of type: " + String(p_node->type));
+		emit(OP_LOAD_NULL, p_dest);
+		break;
+	}
+
+	free_registers(top);
+}
+
+void Compiler::compile_store(ScriptNode *p_target, int p_src)
+{
+	switch (p_target->type)
+	{
+	case ScriptNode::VARIABLE:
+	{
+		VariableNode *var = reinterpret_cast<VariableNode*>(p_target);
+
+		if (var->slot >= 0)
+			emit(OP_MOVE, var->slot, p_src);
+		else
+			emit(OP_SET_VAR, p_src, add_name(var->name));
+		break;
+	}
+
+	case ScriptNode::SUPERVAR:
+		emit(OP_SET_SUPER, p_src, add_node(p_target));
+		break;
+
+	case ScriptNode::PATH:
+	{
+		Path *path = reinterpret_cast<Path*>(p_target);
+		ScriptNode *last = path->path[path->path.size() - 1];
+
+		if (last->type != ScriptNode::MEMBERVAR)
+		{
+			T_ERROR("Can only assign a value to a variable");
+			break;
+		}
+
+		int top = next_register;
+		Array<int> registers;
+
+		compile_chain(path, path->path.size() - 1, registers);
+
+		int object = registers.getlast();
+		emit(OP_SET_MEMBER, object, p_src, add_node(last));
+
+		//a vector or color member changed a copy, it is stored back where it was read from
+		int skip = emit(OP_JUMP_IF_NOT_INLINE, object);
+		compile_write_back(path, registers, registers.size() - 1);
+		patch_jump(skip);
+
+		free_registers(top);
+		break;
+	}
+
+	default:
+		T_ERROR("Expected a variable to assign to");
+		break;
+	}
+}
+
+//the receiver of a member is evaluated once, the member is read and written through it
+void Compiler::compile_modify(ScriptNode *p_target, ScriptNode *p_value, Variant::OperatorType p_op, int p_dest)
+{
+	Path *path = p_target->type == ScriptNode::PATH ? reinterpret_cast<Path*>(p_target) : NULL;
+	ScriptNode *last = path ? path->path[path->path.size() - 1] : NULL;
+
+	int top = next_register;
+	int value = alloc_register();
+	Array<int> registers;
+
+	if (last && last->type == ScriptNode::MEMBERVAR)
+	{
+		compile_chain(path, path->path.size() - 1, registers);
+		emit(OP_GET_MEMBER, p_dest, registers.getlast(), add_node(last));
+	}
+	else
+		compile_expression(p_target, p_dest);
+
+	if (p_value)
+		compile_expression(p_value, value);
+	else
+		emit(OP_LOAD_INT, value, 1);
+
+	int value_type = p_value ? get_result_type(p_value) : Variant::INT;
+	emit(specialize(get_operation(p_op), get_result_type(p_target), value_type), p_dest, p_dest, value);
+
+	if (registers.size() == 0)
+	{
+		compile_store(p_target, p_dest);
+		free_registers(top);
+		return;
+	}
+
+	int object = registers.getlast();
+	emit(OP_SET_MEMBER, object, p_dest, add_node(last));
+
+	//a vector or color member changed a copy, it is stored back where it was read from
+	int skip = emit(OP_JUMP_IF_NOT_INLINE, object);
+	compile_write_back(path, registers, registers.size() - 1);
+	patch_jump(skip);
+
+	free_registers(top);
+}
+
+void Compiler::compile_path(Path *p_path, int p_count, int p_dest)
+{
+	bool calls = false;
+
+	for (int c = 0; c < p_count; c++)
+		calls = calls || p_path->path[c]->type == ScriptNode::MEMBERFUNC;
+
+	//reading members never changes a value, one register is enough
+	if (!calls)
+	{
+		compile_expression(p_path->origin->node, p_dest);
+
+		for (int c = 0; c < p_count; c++)
+			emit(OP_GET_MEMBER, p_dest, p_dest, add_node(p_path->path[c]));
+		return;
+	}
+
+	Array<int> registers;
+
+	compile_chain(p_path, p_count, registers);
+	emit(OP_MOVE, p_dest, registers.getlast());
+}
+
+//every step of the path gets its own register, a method that changes an inline receiver
+//is followed by storing it back up the path
+void Compiler::compile_chain(Path *p_path, int p_count, Array<int> &r_registers)
+{
+	r_registers.push_back(alloc_register());
+	compile_expression(p_path->origin->node, r_registers[0]);
+
+	for (int c = 0; c < p_count; c++)
+	{
+		ScriptNode *n = p_path->path[c];
+		int object = r_registers[c];
+		int dest = alloc_register();
+
+		r_registers.push_back(dest);
+
+		if (n->type == ScriptNode::MEMBERVAR)
+			emit(OP_GET_MEMBER, dest, object, add_node(n));
+		else if (n->type == ScriptNode::MEMBERFUNC)
+		{
+			MemberFunc *mf = reinterpret_cast<MemberFunc*>(n);
+			int top = next_register;
+			int base = alloc_register(mf->args.size() + 1);
+			int node = add_node(n);
+
+			emit(OP_MOVE, base, object);
+			compile_call_arguments(mf->args, base + 1);
+			emit(OP_CALL_MEMBER, dest, base, node);
+
+			int skip_value = emit(OP_JUMP_IF_NOT_INLINE, base);
+			int skip_const = emit(OP_JUMP_IF_CONST_CALL, base, 0, node);
+
+			emit(OP_MOVE, object, base);
+			compile_write_back(p_path, r_registers, c);
+
+			patch_jump(skip_value);
+			patch_jump(skip_const);
+
+			free_registers(top);
+		}
+	}
+}
+
+//stores the inline value in p_registers[p_index] into the member it was read from, up
+//to the first object in the path or to the variable the path starts at
+void Compiler::compile_write_back(Path *p_path, const Array<int> &p_registers, int p_index)
+{
+	Array<int> exits;
+	int c = p_index;
+
+	for (; c > 0; c--)
+	{
+		ScriptNode *n = p_path->path[c - 1];
+
+		if (n->type != ScriptNode::MEMBERVAR)
+			break;
+
+		emit(OP_SET_MEMBER, p_registers[c - 1], p_registers[c], add_node(n));
+		exits.push_back(emit(OP_JUMP_IF_NOT_INLINE, p_registers[c - 1]));
+	}
+
+	ScriptNode *origin = p_path->origin->node;
+
+	if (c == 0 && (origin->type == ScriptNode::VARIABLE || origin->type == ScriptNode::SUPERVAR))
+		compile_store(origin, p_registers[0]);
+
+	for (int e = 0; e < exits.size(); e++)
+		patch_jump(exits[e]);
+}
+
+void Compiler::compile_if(If *p_if)
+{
+	Array<int> exits;
+	int test = alloc_register();
+
+	for (int c = 0; c < p_if->elements.size(); c++)
+	{
+		IfElement *e = p_if->elements[c];
+
+		if (e->branch != IfElement::BRANCH_ELSE)
+		{
+			compile_expression(e->passtest, test);
+			int skip = emit(OP_JUMP_IF_FALSE, test);
+
+			compile_block(e->node);
+			exits.push_back(emit(OP_JUMP));
+
+			patch_jump(skip);
+		}
+		else
+			compile_block(e->node);
+	}
+
+	for (int c = 0; c < exits.size(); c++)
+		patch_jump(exits[c]);
+}
+
+void Compiler::compile_while(WhileLoop *p_loop)
+{
+	int test = alloc_register();
+	int start = get_position();
+
+	compile_expression(p_loop->passcheck, test);
+	int exit = emit(OP_JUMP_IF_FALSE, test);
+
+	compile_statement(p_loop->func);
+	emit(OP_JUMP, start);
+
+	patch_jump(exit);
+}
+
+void Compiler::compile_for(ForLoop *p_loop)
+{
+	int test = alloc_register();
+
+	compile_statement(p_loop->decl);
+
+	int start = get_position();
+
+	compile_expression(p_loop->passcheck, test);
+	int exit = emit(OP_JUMP_IF_FALSE, test);
+
+	compile_statement(p_loop->func);
+	compile_statement(p_loop->update);
+	emit(OP_JUMP, start);
+
+	patch_jump(exit);
+}
+
+void Compiler::compile_and(And *p_and, int p_dest)
+{
+	compile_expression(p_and->left, p_dest);
+	int skip = emit(OP_JUMP_IF_FALSE, p_dest);
+
+	compile_expression(p_and->right, p_dest);
+	int exit = emit(OP_JUMP);
+
+	patch_jump(skip);
+	emit(OP_LOAD_BOOL, p_dest, false);
+	patch_jump(exit);
+}
+
+void Compiler::compile_or(Or *p_or, int p_dest)
+{
+	compile_expression(p_or->left, p_dest);
+	int pass_left = emit(OP_JUMP_IF_TRUE, p_dest);
+
+	compile_expression(p_or->right, p_dest);
+	int pass_right = emit(OP_JUMP_IF_TRUE, p_dest);
+
+	emit(OP_LOAD_BOOL, p_dest, false);
+	int exit = emit(OP_JUMP);
+
+	patch_jump(pass_left);
+	patch_jump(pass_right);
+	emit(OP_LOAD_BOOL, p_dest, true);
+	patch_jump(exit);
+}
+
+void Compiler::compile_call_arguments(const ScriptVector<ScriptNode> &p_args, int p_base)
+{
+	for (int c = 0; c < p_args.size(); c++)
+		compile_expression(p_args[c], p_base + c);
+}
+
+OpCode Compiler::get_operation(Variant::OperatorType p_op)
+{
+	switch (p_op)
+	{
+	case Variant::SUBTRACT: return OP_SUBTRACT;
+	case Variant::MULTIPLY: return OP_MULTIPLY;
+	case Variant::DIVIDE: return OP_DIVIDE;
+	default: return OP_ADD;
+	}
+}
+
+OpCode Compiler::get_comparison(Variant::EvaluationType p_eval)
+{
+	switch (p_eval)
+	{
+	case Variant::LESS: return OP_LESS;
+	case Variant::LEQUAL: return OP_LEQUAL;
+	case Variant::NOTEQUAL: return OP_NOTEQUAL;
+	case Variant::GREATER: return OP_GREATER;
+	case Variant::GEQUAL: return OP_GEQUAL;
+	default: return OP_EQUAL;
+	}
+}
+
+OpCode Compiler::specialize(OpCode p_op, int p_left, int p_right)
+{
+	if (p_op >= OP_ADD && p_op <= OP_DIVIDE)
+	{
+		int offset = p_op - OP_ADD;
+		int vector = p_left - Variant::VEC2;		//0 to 2 for vec2 to vec4
+
+		if (p_left == Variant::INT && p_right == Variant::INT)
+			return static_cast<OpCode>(OP_ADD_INT + offset);
+
+		if (p_left == Variant::FLOAT && p_right == Variant::FLOAT)
+			return static_cast<OpCode>(OP_ADD_FLOAT + offset);
+
+		if (vector >= 0 && vector <= 2 && p_right == p_left)
+			return static_cast<OpCode>(OP_ADD_VEC2 + vector * 4 + offset);
+
+		if (vector >= 0 && vector <= 2 && p_right == Variant::FLOAT)
+			return static_cast<OpCode>(OP_ADD_VEC2_FLOAT + vector * 4 + offset);
+	}
+	else if (p_op >= OP_LESS && p_op <= OP_GEQUAL)
+	{
+		int offset = p_op - OP_LESS;
+
+		if (p_left == Variant::INT && p_right == Variant::INT)
+			return static_cast<OpCode>(OP_LESS_INT + offset);
+
+		if (p_left == Variant::FLOAT && p_right == Variant::FLOAT)
+			return static_cast<OpCode>(OP_LESS_FLOAT + offset);
+	}
+
+	return p_op;
+}
+
+int Compiler::get_result_type(ScriptNode *p_node)
+{
+	return p_node ? p_node->result_type : Variant::UNDEF;
+}
+
+//=========================================================================
+//Emit
+//=========================================================================
+
+int Compiler::emit(OpCode p_op, int p_a, int p_b, int p_c)
+{
+	Instruction ins;
+	ins.op = static_cast<unsigned short>(p_op);
+	ins.a = static_cast<unsigned short>(p_a);
+	ins.b = static_cast<unsigned short>(p_b);
+	ins.c = static_cast<unsigned short>(p_c);
+
+	function->code.push_back(ins);
+	function->lines.push_back(line);
+	return function->code.size() - 1;
+}
+
+int Compiler::get_position() const
+{
+	return function->code.size();
+}
+
+void Compiler::patch_jump(int p_index)
+{
+	Instruction &ins = function->code[p_index];
+
+	//unconditional jumps keep their target in a, conditional jumps in b
+	if (ins.op == OP_JUMP)
+		ins.a = static_cast<unsigned short>(get_position());
+	else
+		ins.b = static_cast<unsigned short>(get_position());
+}
+
+//=========================================================================
+//Registers
+//=========================================================================
+
+int Compiler::alloc_register(int p_count)
+{
+	int result = next_register;
+	next_register += p_count;
+
+	if (next_register > function->register_count)
+		function->register_count = next_register;
+
+	return result;
+}
+
+void Compiler::free_registers(int p_top)
+{
+	next_register = p_top;
+}
+
+//=========================================================================
+//Tables
+//=========================================================================
+
+int Compiler::add_constant(const Variant &p_constant)
+{
+	function->constants.push_back(p_constant);
+	return function->constants.size() - 1;
+}
+
+int Compiler::add_name(const StringName &p_name)
+{
+	for (int c = 0; c < function->names.size(); c++)
+		if (function->names[c] == p_name)
+			return c;
+
+	function->names.push_back(p_name);
+	return function->names.size() - 1;
+}
+
+int Compiler::add_node(ScriptNode *p_node)
+{
+	function->nodes.push_back(p_node);
+	return function->nodes.size() - 1;
+}
+
+int Compiler::add_call_site(FunctionCall *p_call)
+{
+	CallSite site;
+	site.name = p_call->name;
+	site.arg_count = p_call->params.size();
+	site.target = state->FuncExists(p_call->name) ? state->GetFunc(p_call->name) : NULL;
+
+	function->call_sites.push_back(site);
+	return function->call_sites.size() - 1;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/Data.h"
+#include "Bytecode.h"
+
+//Lowers the ScriptNode tree of a function into bytecode for the VirtualMachine
+class Compiler
+{
+public:
+	Compiler(State *p_state);
+
+	//compile every function defined at the top level of the script
+	void compile_all(const Line &p_root);
+
+	CompiledFunction* compile(Function *p_function);
+
+private:
+	void compile_block(Block *p_block);
+	void compile_statement(ScriptNode *p_node);
+	void compile_expression(ScriptNode *p_node, int p_dest);
+	void compile_store(ScriptNode *p_target, int p_src);
+
+	//p_target op= p_value, or ++ and -- when p_value is NULL
+	void compile_modify(ScriptNode *p_target, ScriptNode *p_value, Variant::OperatorType p_op, int p_dest);
+
+	//evaluate the origin and the first p_count members of a path
+	void compile_path(Path *p_path, int p_count, int p_dest);
+	void compile_chain(Path *p_path, int p_count, Array<int> &r_registers);
+	void compile_write_back(Path *p_path, const Array<int> &p_registers, int p_index);
+
+	void compile_if(If *p_if);
+	void compile_while(WhileLoop *p_loop);
+	void compile_for(ForLoop *p_loop);
+	void compile_and(And *p_and, int p_dest);
+	void compile_or(Or *p_or, int p_dest);
+	void compile_call_arguments(const ScriptVector<ScriptNode> &p_args, int p_base);
+
+	//map the operators decoded by the Parser onto opcodes
+	static OpCode get_operation(Variant::OperatorType p_op);
+	static OpCode get_comparison(Variant::EvaluationType p_eval);
+
+	//the typed opcode for p_op when the operand types have one, p_op otherwise
+	static OpCode specialize(OpCode p_op, int p_left, int p_right);
+	static int get_result_type(ScriptNode *p_node);
+
+	//emit
+	int emit(OpCode p_op, int p_a = 0, int p_b = 0, int p_c = 0);
+	int get_position() const;
+	void patch_jump(int p_index);
+
+	//registers
+	int alloc_register(int p_count = 1);
+	void free_registers(int p_top);
+
+	//tables
+	int add_constant(const Variant &p_constant);
+	int add_name(const StringName &p_name);
+	int add_node(ScriptNode *p_node);
+	int add_call_site(FunctionCall *p_call);
+
+	State *state;
+	CompiledFunction *function;
+	int next_register;
+
+	//source line of the statement being compiled
+	int line;
+};
@@ -1,91 +1,58 @@
 #include "Executer.h"
 
-#include "core/Memory.h"
+#include "ScriptProfiler.h"
 #include "types/MethodMaster.h"
 
 Executer::Executer()
 {
-
+	frame_base = 0;
 }
 
 Executer::Executer(Line line, State *state)
 {
 	this->state = state;
+	frame_base = 0;
 
 	for (int c = 0; c < line.sub.size(); c++)
 		Execute(line.sub[c]->node);
 }
 
-Variant Executer::run_method(Method *m, Array<Variant> &args)
+Variant Executer::run_method(Method *m, const Variant *p_args, int p_arg_count)
 {
-	if (m->returns_variant)
-	{
-		switch (m->arg_count)
-		{
-		case 0:
-			return dynamic_cast<R_Method_0*>(m)->operator()();
-
-		case 1:
-			return dynamic_cast<R_Method_1*>(m)->operator()(
-				args[0]);
-
-		case 2:
-			return dynamic_cast<R_Method_2*>(m)->operator()(
-				args[0], args[1]);
-
-		case 3:
-			return dynamic_cast<R_Method_3*>(m)->operator()(
-				args[0], args[1], args[2]);
+	Variant result;
 
-		case 4:
-			return dynamic_cast<R_Method_4*>(m)->operator()(
-				args[0], args[1], args[2], args[3]);
-		}
-	}
-	else
+	if (p_arg_count < m->arg_count)
 	{
-		switch (m->arg_count)
-		{
-		case 0:
-			dynamic_cast<V_Method_0*>(m)->operator()();
-			break;
+		T_ERROR("Number of arguments does not match for method: " + m->name.get_source());
+		return result;
+	}
 
-		case 1:
-			dynamic_cast<V_Method_1*>(m)->operator()(
-				args[0]);
-			break;
+	m->call(p_args, result);
+	return result;
+}
 
-		case 2:
-			dynamic_cast<V_Method_2*>(m)->operator()(
-				args[0], args[1]);
-			break;
+Variant Executer::run_method(Method *m, Array<Variant> &args)
+{
+	return run_method(m, args.size() > 0 ? &args[0] : NULL, args.size());
+}
 
-		case 3:
-			dynamic_cast<V_Method_3*>(m)->operator()(
-				args[0], args[1], args[2]);
-			break;
+Variant Executer::run_member_func(Variant &object, MemberFunc *mf)
+{
+	Variant args[MAX_METHOD_ARGS];
+	int arg_count = mf->args.size() + 1;
 
-		case 4:
-			dynamic_cast<V_Method_4*>(m)->operator()(
-				args[0], args[1], args[2], args[3]);
-			break;
-		}
+	if (arg_count > MAX_METHOD_ARGS)
+	{
+		T_ERROR("Too many arguments for method: " + mf->method_name);
 		return Variant();
 	}
-	return Variant();
-}
 
-Variant Executer::run_member_func(Variant &object, MemberFunc *mf)
-{
-	Array<Variant> args;
-	args.push_back(object);
+	args[0] = object;
 
 	for (int c = 0; c < mf->args.size(); c++)	//Get arguments
-		args.push_back(Execute(mf->args[c]));
+		args[c + 1] = Execute(mf->args[c]);
 
-	VariantType t = object.get_type();
-
-	Method *m = MMASTER->get_method(t, mf->method_name);
+	Method *m = mf->get_method(object);
 
 	if (!m)
 	{
@@ -93,7 +60,13 @@ Variant Executer::run_member_func(Variant &object, MemberFunc *mf)
 		return Variant();
 	}
 
-	return run_method(m, args);
+	Variant result = run_method(m, args, arg_count);
+
+	//the method changed a copy of an inline receiver
+	if (object.is_inline() && !m->is_const)
+		object = args[0];
+
+	return result;
 }
 
 Variant Executer::GetMemberMinusOne(const Path &var)
@@ -105,41 +78,101 @@ Variant Executer::GetMemberMinusOne(const Path &var)
 
 Variant Executer::GetMember(const Path &var)
 {
-	Variant cur = Execute(var.origin->node);
-	
-	for (int c = 0; c < var.path.size(); c++)		//Get each member
+	Array<Variant> values;
+
+	if (!get_chain(var, var.path.size(), values))
+		return NULL_VAR;
+
+	return values.getlast();
+}
+
+//the values along the first p_count steps of a path, r_values[0] holds the origin
+bool Executer::get_chain(const Path &var, int p_count, Array<Variant> &r_values)
+{
+	r_values.push_back(Execute(var.origin->node));
+
+	for (int c = 0; c < p_count; c++)		//Get each member
 	{
 		ScriptNode *n = var.path[c];
+		Variant cur = r_values[c];
 
 		if (!cur.isdef())
 		{
 			T_ERROR("Path error");
-			return NULL_VAR;
+			return false;
 		}
 
 		if (n->type == ScriptNode::MEMBERVAR)					//Get member variable
 		{
 			MemberVar *memvar = dynamic_cast<MemberVar*>(n);
 
-			Property *p = MMASTER->get_property(cur.get_type(), memvar->variable_name);
+			Property *p = memvar->get_property(cur);
 
 			if (p)
-				cur = p->get->operator()(cur);
+				r_values.push_back(p->get->operator()(cur));
 			else
 			{
 				T_ERROR("Path error");
-				return NULL_VAR;
+				return false;
 			}
 		}
 
 		else if (n->type == ScriptNode::MEMBERFUNC)			//Execute member function
 		{
 			MemberFunc *fc = (MemberFunc*)n;
-			cur = run_member_func(cur, fc);
+			Method *m = fc->get_method(cur);
+
+			r_values.push_back(run_member_func(cur, fc));
+
+			if (cur.is_inline() && m && !m->is_const)
+			{
+				r_values[c] = cur;
+				write_back(var, r_values, c);
+			}
 		}
 	}
-		
-	return cur; 
+
+	return true;
+}
+
+//stores the inline value r_values[p_index] into the member it was read from, up to the
+//first object in the path or to the variable the path starts at
+void Executer::write_back(const Path &var, Array<Variant> &r_values, int p_index)
+{
+	int c = p_index;
+
+	for (; c > 0; c--)
+	{
+		ScriptNode *n = var.path[c - 1];
+
+		if (n->type != ScriptNode::MEMBERVAR)
+			return;
+
+		Property *p = reinterpret_cast<MemberVar*>(n)->get_property(r_values[c - 1]);
+
+		if (!p || !set_member(p, r_values[c - 1], r_values[c]))
+			return;
+	}
+
+	ScriptNode *origin = var.origin->node;
+
+	if (origin->type == ScriptNode::VARIABLE || origin->type == ScriptNode::SUPERVAR)
+		SetVariable(origin, r_values[0]);
+}
+
+//returns whether r_object is an inline value, which only changed in this copy
+bool Executer::set_member(Property *p, Variant &r_object, const Variant &p_value)
+{
+	Variant args[] = { r_object, p_value };
+	Variant result;
+
+	p->set->call(args, result);
+
+	if (!args[0].is_inline())
+		return false;
+
+	r_object = args[0];
+	return true;
 }
 
 Property* Executer::get_property(const Path &var)
@@ -156,7 +189,7 @@ Property* Executer::get_property(const Path &var)
 		{
 			memvar = dynamic_cast<MemberVar*>(n);
 
-			p = MMASTER->get_property(cur.get_type(), memvar->variable_name);
+			p = memvar->get_property(cur);
 
 			if (p)
 				cur = p->get->operator()(cur);
@@ -181,21 +214,21 @@ void Executer::SetVariable(ScriptNode *node, Variant val)
 {
 	if (node->GetType() == ScriptNode::PATH)
 	{
-		Path path = *reinterpret_cast<Path*>(node);
+		const Path &path = *reinterpret_cast<Path*>(node);
 
 		ScriptNode *last = path.path[path.path.size() - 1];
-		Property *p = get_property(path);
+		Array<Variant> values;
 
 		if (last->type != ScriptNode::MEMBERVAR)
 			T_ERROR("Can only assign a value to a variable");
-		else
+		else if (get_chain(path, path.path.size() - 1, values))
 		{
-			Variant v = GetMemberMinusOne(path);
+			Property *p = reinterpret_cast<MemberVar*>(last)->get_property(values.getlast());
 
 			if (p)
 			{
-				p->set->operator()(v, val);
-				GC->queue_clean(val);
+				if (set_member(p, values.getlast(), val))
+					write_back(path, values, values.size() - 1);
 			}
 			else
 				T_ERROR("Property does not exist");
@@ -204,17 +237,32 @@ void Executer::SetVariable(ScriptNode *node, Variant val)
 	else if (node->GetType() == ScriptNode::VARIABLE)
 	{
 		VariableNode *var = (VariableNode*)node;
-		state->SetVar(var->name, val);
+
+		if (var->slot >= 0)
+			set_slot(var->slot, val);
+		else
+			state->SetVar(var->name, val);
 	}
 	else if (node->GetType() == ScriptNode::SUPERVAR)
 	{
 		SuperVariable *var = (SuperVariable*)node;
 		var->property->set->operator()(state->extension, val);
-		GC->queue_clean(val);
 	}
 }
 
-Variant Executer::run_titan_func(const String &name, Array<Variant> paras)
+void Executer::set_slot(int p_slot, const Variant &p_value)
+{
+	slots[frame_base + p_slot] = p_value;
+}
+
+Variant Executer::run_titan_func(const String &name, const Arguments &paras)
+{
+	StringName sname = name;
+
+	return run_titan_func(state->FuncExists(sname) ? state->GetFunc(sname) : NULL, paras);
+}
+
+Variant Executer::run_titan_func(Function *p_function, const Arguments &paras)
 {
 	state->popparas();
 	state->clearparams();
@@ -222,13 +270,26 @@ Variant Executer::run_titan_func(const String &name, Array<Variant> paras)
 	for (int c = 0; c < paras.size(); c++)
 		state->addparam(paras[c]);						//Add parameters to stack
 	
-	if (state->FuncExists(StringName(name)))
-		Execute(state->GetFunc(StringName(name))->block);			//Execute user-defined function
+	if (p_function)
+		execute_function(p_function);					//Execute user-defined function
 
 	state->clearparams();
 	return state->GetReturns();							//Get and clear returns
 }
 
+void Executer::execute_function(Function *p_function)
+{
+	bool profiled = ScriptProfiler::active;
+
+	if (profiled)
+		PROFILER->enter(state, p_function, NULL, NULL);
+
+	Execute(p_function->block);
+
+	if (profiled)
+		PROFILER->leave();
+}
+
 Variant Executer::Execute(ScriptNode *node)
 {
 	if (!node)											//Ignore else and elseif statments
@@ -265,24 +326,14 @@ Variant Executer::Execute(ScriptNode *node)
 		Sum *sum = (Sum*)node;
 		Variant left = Execute(sum->left);
 		Variant right = Execute(sum->right);
-		Variant res = (sum->op == "+") ? left + right : left - right;
-
-		GC->queue_clean(left);
-		GC->queue_clean(right);
-
-		return res;
+		return left.operate(sum->op, right);
 	}
 	else if (type == ScriptNode::PRODUCT)
 	{
-		Sum *sum = (Sum*)node;
-		Variant left = Execute(sum->left);
-		Variant right = Execute(sum->right);
-		Variant res = (sum->op == "*") ? left * right : left / right;
-
-		GC->queue_clean(left);
-		GC->queue_clean(right);
-
-		return res;
+		Product *pro = (Product*)node;
+		Variant left = Execute(pro->left);
+		Variant right = Execute(pro->right);
+		return left.operate(pro->op, right);
 	}
 	else if (type == ScriptNode::AND)
 	{
@@ -327,6 +378,9 @@ Variant Executer::Execute(ScriptNode *node)
 	else if (type == ScriptNode::VARIABLE)
 	{
 		VariableNode *var = (VariableNode*)node;
+
+		if (var->slot >= 0)
+			return slots[frame_base + var->slot];
 		
 		Variant* value = state->GetVar(var->name);
 
@@ -348,7 +402,7 @@ Variant Executer::Execute(ScriptNode *node)
 		{
 			IfElement *e = ifstat->elements[c];
 
-			if (e->name == "if" || e->name == "elseif")
+			if (e->branch != IfElement::BRANCH_ELSE)
 			{
 				Variant res = Execute(e->passtest);
 
@@ -359,7 +413,7 @@ Variant Executer::Execute(ScriptNode *node)
 				}
 			}
 			else
-				Execute(e->node); //e->name == "else"
+				Execute(e->node);
 		}
 
 		return 0;
@@ -367,15 +421,26 @@ Variant Executer::Execute(ScriptNode *node)
 	else if (type == ScriptNode::BLOCK)
 	{
 		Block *block = (Block*) node;
+		int previous_base = frame_base;
 		returntofunc = false;
 
 		if (block->params.size() != state->argcount())
 			T_ERROR("Number of arguments does not match");
 
+		if (block->isfunction)								//Open a frame for the locals
+		{
+			frame_base = slots.size();
+			slots.resize(frame_base + block->slot_count);
+		}
+
 		for (int c = 0; c < block->params.size(); c++) //Introduce parameters as local vars
 		{
 			VariableNode* var = (VariableNode*) block->params[c];
-			state->SetVar(var->name, state->getval(c));
+
+			if (var->slot >= 0)
+				slots[frame_base + var->slot] = state->getval(c);
+			else
+				state->SetVar(var->name, state->getval(c));
 		}
 
 		state->clearparams();
@@ -383,7 +448,17 @@ Variant Executer::Execute(ScriptNode *node)
 		for (int c = 0; c < block->lines.size(); c++) //Execute titancode
 		{
 			if ((!returntofunc && block->isfunction) || !block->isfunction)
+			{
+				if (ScriptProfiler::active && block->lines[c])
+				{
+					PROFILER->set_line(block->lines[c]->line);
+
+					if (ScriptProfiler::has_pending_ticks())
+						PROFILER->sample();
+				}
+
 				Execute(block->lines[c]);
+			}
 			else if (returntofunc && !block->isfunction)
 				break;
 			else if (returntofunc && block->isfunction)
@@ -396,7 +471,17 @@ Variant Executer::Execute(ScriptNode *node)
 		for (int c = 0; c < block->params.size(); c++) //Delete arguments
 		{
 			VariableNode* var = (VariableNode*)block->params[c];
-			state->DeleteVar(var->name);
+
+			if (var->slot >= 0)
+				slots[frame_base + var->slot].clean();
+			else
+				state->DeleteVar(var->name);
+		}
+
+		if (block->isfunction)								//Close the frame
+		{
+			slots.resize(frame_base);
+			frame_base = previous_base;
 		}
 
 		return 0;
@@ -418,8 +503,8 @@ Variant Executer::Execute(ScriptNode *node)
 			state->addparam(Execute(call->params[c]));		//Add parameters to stack
 
 		if (state->FuncExists(call->name.get_source()))
-			Execute(state->GetFunc(call->name.get_source())->block);		//Execute user-defined function
-		else if (call->name == StringName("print"))
+			execute_function(state->GetFunc(call->name.get_source()));		//Execute user-defined function
+		else if (call->name == CORE_NAMES->print)
 			T_LOG(state->getval(0).ToString());
 		else
 			T_ERROR("Function: " + call->name.get_source() + " does not exist!");
@@ -436,7 +521,8 @@ Variant Executer::Execute(ScriptNode *node)
 		for (int c = 0; c < call->params.size(); c++)
 			state->addparam(Execute(call->params[c]));		//Add parameters to stack
 
-		state->addreturn(run_method(MMASTER->static_funcs[call->name], Array<Variant>(state->getval(0))));
+		Variant param = state->getval(0);
+		state->addreturn(run_method(MMASTER->static_funcs[call->name], &param, 1));
 
 		state->pushparas();
 		return state->GetReturns();
@@ -452,7 +538,7 @@ Variant Executer::Execute(ScriptNode *node)
 		for (int c = 0; c < call->params.size(); c++)
 			state->addparam(Execute(call->params[c]));		//Add parameters to stack
 		
-		Method *m = MMASTER->get_method(state->extensiontype, call->name);
+		Method *m = call->get_method(state->extension);
 		Variant result = run_method(m, state->GetArgs());
 
 		state->pushparas();
@@ -511,7 +597,7 @@ Variant Executer::Execute(ScriptNode *node)
 		Variant var = Execute(one->var);
 		Variant onenum = 1;
 
-		SetVariable(one->var, var + onenum);
+		SetVariable(one->var, var.operate(one->op, onenum));
 		onenum.clean();
 		return 0;
 	}
@@ -519,18 +605,10 @@ Variant Executer::Execute(ScriptNode *node)
 	{
 		Comparison *comp = (Comparison*)node;
 
-		bool result = false;
 		Variant left = Execute(comp->left);
 		Variant right = Execute(comp->right);
 
-		if		(comp->name == "<") result = left < right;
-		else if (comp->name == ">") result = left > right;
-		else if (comp->name == "<=") result = left <= right;
-		else if (comp->name == ">=") result = left >= right;
-		else if (comp->name == "==") result = left == right;
-		else if (comp->name == "!=") result = left == right;
-
-		return result;
+		return left.eval_comp(comp->eval, right);
 	}
 	else if (type == ScriptNode::COMPOSITION)
 	{
@@ -548,12 +626,7 @@ Variant Executer::Execute(ScriptNode *node)
 		Variant val = Execute(mod->val);
 		Variant var = Execute(mod->var);
 
-		if		(mod->op == "+=") val = var + Execute(mod->val);
-		else if (mod->op == "-=") val = var - Execute(mod->val);
-		else if (mod->op == "*=") val = var * Execute(mod->val);
-		else if (mod->op == "/=") val = var / Execute(mod->val);
-
-		SetVariable(mod->var, val);
+		SetVariable(mod->var, var.operate(mod->op, val));
 		return 0;
 	}
 	else if (type == ScriptNode::ORIENTATION)
@@ -561,16 +634,12 @@ Variant Executer::Execute(ScriptNode *node)
 		Orientation *o = (Orientation*)node;
 		Variant value = Execute(o->right);
 
-		if (value.type == Variant::INT)
-		{
-			int mult = o->o == '+' ? 1 : -1;
-			return Variant(Execute(o->right).i * mult);
-		}
+		if (!o->negate)
+			return value;
+		else if (value.type == Variant::INT)
+			return Variant(-value.i);
 		else
-		{
-			float mult = o->o == '+' ? 1.0f : -1.0f;
-			return Variant(Execute(o->right).f * mult);
-		}
+			return Variant(-value.f);
 	}
 	else if (type == ScriptNode::NOT)
 	{
@@ -607,5 +676,10 @@ Variant Executer::Execute(ScriptNode *node)
 		Variant r = MMASTER->get_singleton(ts->referenced_type);
 		return r;
 	}
+	else if (type == ScriptNode::YIELD)
+	{
+		T_ERROR("yield and wait need the bytecode execution mode");
+		return Variant();
+	}
 	return 0;
 }
\ No newline at end of file
@@ -13,7 +13,9 @@ public:
 
 	~Executer() { delete state; }
 
-	Variant run_method(Method * m, Array<Variant>& args);
+	//calls the thunk of m, p_args holds the object first for member methods
+	static Variant run_method(Method *m, const Variant *p_args, int p_arg_count);
+	static Variant run_method(Method *m, Array<Variant> &args);
 
 	Variant GetMemberMinusOne(const Path &var);
 	Variant GetMember(const Path &var);
@@ -21,9 +23,11 @@ public:
 	Property* get_property(const Path &var);
 
 	void SetVariable(ScriptNode *node, Variant val);
+	void set_slot(int p_slot, const Variant &p_value);
 
 	Variant run_member_func(Variant &object, MemberFunc *mf);
-	Variant run_titan_func(const String &name, Array<Variant> paras);
+	Variant run_titan_func(const String &name, const Arguments &paras);
+	Variant run_titan_func(Function *p_function, const Arguments &paras);
 
 	Variant Execute(ScriptNode *node);
 
@@ -31,6 +35,19 @@ public:
 	Block *activefunc;
 
 	bool returntofunc;
+
+private:
+	//values that are stored inline are copies, changing a member of one is written back up the path
+	bool get_chain(const Path &var, int p_count, Array<Variant> &r_values);
+	void write_back(const Path &var, Array<Variant> &r_values, int p_index);
+	static bool set_member(Property *p, Variant &r_object, const Variant &p_value);
+
+	//runs the block of a script function, as a frame of the profiler when it is active
+	void execute_function(Function *p_function);
+
+	//locals of the running functions, each call uses slot_count entries from frame_base
+	Array<Variant> slots;
+	int frame_base;
 };
 
 struct SimpleExecuter
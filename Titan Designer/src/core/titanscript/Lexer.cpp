@@ -1,8 +1,15 @@
 #include "Lexer.h"
 
+#include <cstring>
+
+//perfect hash of the keywords: (first * 4 + last) % 6
+static const char *keyword_table[6] = { "if", "else", "elseif", "func", "var", NULL };
+
 Lexer::Lexer(const String &src)
 {
 	source = src;
+	text = store(source).src;
+
 	Lex();
 }
 
@@ -17,65 +24,77 @@ void Lexer::Free()
 
 void Lexer::LexBlock()
 {
-	Line *l;
-	while(index < lines.size() && !finishedlexing)
+	Array<Line*> lexed;
+	lexed.reserve(lines.size());
+
+	for (int c = 0; c < lines.size(); c++)
 	{
-		l = new Line(LexLine(lines[index]));
+		Line *l = LexLine(lines[c]);
 
-		if (l->tokens.size() == 0 || l->StartsWith("//"))
-			continue;		//Skip if line is comment or empty
+		if (l->tokens.size() == 0 && l->level == 0)						//Skip if line has nothing to parse
+		{
+			delete l;
+			continue;
+		}
 
-		l->level = StringUtils::CountTabs(lines[index]);				//Indentation
+		lexed.push_back(l);
+	}
 
-		for (int c = 0; c < l->level; c++)								//Remove Tabs
-			l->tokens.clear(0);
+	for (int c = 0; c < lexed.size(); c++)
+	{
+		Line *l = lexed[c];
 
 		parentstack.getlast()->sub.push_back(l);
 
-		if (index + 1 == lines.size())									//Return at End of File
-		{
-			finishedlexing = true;
+		if (c + 1 == lexed.size())										//Return at End of File
 			return;
-		}
 
-		int tabcount = StringUtils::CountTabs(lines[++index]);			//#tabs of next line
+		int tabcount = lexed[c + 1]->level;								//#tabs of next line
 
 		if (tabcount > l->level)										//Lex new block
-		{
 			parentstack.push_back(l);
-			LexBlock();
-		}
 		else if (tabcount < l->level)									//End Block
 		{
-			for (int c = 0; c < l->level - tabcount; c++)
+			for (int i = 0; i < l->level - tabcount && parentstack.size() > 1; i++)
 				parentstack.removelast();
-
-			return;
 		}
 	}
 }
 
 void Lexer::GetLines()
 {
-	String line = "";
-	for (int c = 0; c < source.length(); c++)
+	const char *src = source.c_str();
+	int length = source.length();
+	int begin = 0, end = -1, number = 1;
+
+	for (int c = 0; c < length; c++)
 	{
-		if (source[c] == '/' && source[c + 1] == '/')
+		if (src[c] == '/' && c + 1 < length && src[c + 1] == '/')		//Comments run to the end of the line
 		{
-			for(; true; c++)
-			{
-				if (source[c] == '\n')
-					break;
-			}
+			end = c;
+
+			for (; c < length && src[c] != '\n'; c++);
+
+			if (c == length)
+				break;
 		}
 
-		line += source[c]; //Fill line
-		if (source[c] == '\n' || source[c] == '\r' /*|| source[c] == ';' || (source[c] == '/' && source[c + 1] == '/')*/) //Pass line
+		if (src[c] == '\n' || src[c] == '\r')							//Pass line
 		{
-			if (StringUtils::Trim(line) != "")
-				lines.push_back(line);
+			LineSpan span = { begin, end == -1 ? c : end, src[c], number };
+			bool white = src[c] == '\n';
+
+			for (int i = span.begin; i < span.end && white; i++)
+				white = src[i] == '\n' || src[i] == '\t' || src[i] == ' ';
+
+			if (!white)
+				lines.push_back(span);
 
-			line = "";
+			begin = c + 1;
+			end = -1;
+
+			if (src[c] == '\n')
+				number++;
 		}
 	}
 }
@@ -88,44 +107,114 @@ void Lexer::Lex()
 	parentstack.push_back(&root);	//Root is the first Parent
 	LexBlock();
 	parentstack.clear();
+	lines.clear();
+}
+
+Line* Lexer::LexLine(const LineSpan &span)
+{
+	const char *src = source.c_str();
+	Line *line = new Line;
+	int start = span.begin;
+
+	while (start < span.end && src[start] == '\t')						//Indentation
+		start++;
+
+	line->level = start - span.begin;
+	line->number = span.number;
+
+	SplitLine(span, start, *line);
+	return line;
 }
 
-Line Lexer::LexLine(const String &txt)
+void Lexer::AddToken(Line &line, int start, int length)
 {
-	Line line = SplitLine(txt);
+	int type = GetTokenType(text + start, length);
+
+	if (type == -1)
+		return;
+
+	Token token(TokenText(text + start, length), type);
+
+	//words are interned once here instead of every time the Parser looks one up
+	if (type == Token::WORD || type == Token::KEYWORD)
+		token.name = StringName(String(text + start, length));
+
+	line.tokens.push_back(token);
+}
 
-	for (int c = 0; c < line.strings.size(); c++)
+//tokens outlive the Lexer, their text is copied to the arena. Without one it stays in the Lexer
+TokenText Lexer::store(const String &p_text)
+{
+	ScriptArena *arena = ScriptArena::get_current();
+
+	if (!arena)
 	{
-		if (StringUtils::IsTab((line.strings[c])[0]))
-			line.tokens.push_back(Token(line.strings[c], Token::TAB));		//Add Tab
-		else if (StringUtils::IsNumber(line.strings[c]))
-			line.tokens.push_back(Token(line.strings[c], Token::NUMBER));	//Add Number
-		else if (StringUtils::IsKeyword(line.strings[c]))
-			line.tokens.push_back(Token(line.strings[c], Token::KEYWORD));	//Add Keyword
-		else if (StringUtils::IsVariable(line.strings[c]))
-			line.tokens.push_back(Token(line.strings[c], Token::WORD));		//Add Word
-		else if (StringUtils::IsOperator((line.strings[c])[0]))
-			line.tokens.push_back(Token(line.strings[c], Token::OPERATOR));	//Add Operator
-		else if (StringUtils::IsString(line.strings[c]))
-			line.tokens.push_back(Token(line.strings[c], Token::STRING));	//Add String
+		stored.push_back(p_text);
+		return TokenText(stored.back().c_str(), p_text.length());
 	}
-	return line;
+
+	char *copy = static_cast<char*>(arena->allocate_buffer(p_text.length() + 1));
+	memcpy(copy, p_text.c_str(), p_text.length() + 1);
+
+	return TokenText(copy, p_text.length());
+}
+
+int Lexer::GetTokenType(const char *text, int length)
+{
+	if (length > 0 && StringUtils::IsTab(text[0]))
+		return Token::TAB;
+
+	bool number = true, word = true;
+
+	for (int c = 0; c < length; c++)
+	{
+		bool digit = StringUtils::IsNumber(text[c]) || StringUtils::IsDot(text[c]);
+
+		number = number && digit;
+		word = word && (digit || StringUtils::IsLetter(text[c]));
+	}
+
+	if (number)
+		return Token::NUMBER;
+	else if (IsKeyword(text, length))
+		return Token::KEYWORD;
+	else if (word)
+		return Token::WORD;
+	else if (StringUtils::IsOperator(text[0]))
+		return Token::OPERATOR;
+	else if (text[0] == '"' && text[length - 1] == '"')
+		return Token::STRING;
+
+	return -1;
 }
-Line Lexer::SplitLine(const String &txt)
+
+bool Lexer::IsKeyword(const char *text, int length)
 {
+	unsigned char first = text[0], last = text[length - 1];
+	const char *keyword = keyword_table[(first * 4 + last) % 6];
+
+	return keyword && static_cast<int>(strlen(keyword)) == length && strncmp(keyword, text, length) == 0;
+}
+
+//Same splitting rules as before, but the buffer is a range of the source
+void Lexer::SplitLine(const LineSpan &span, int start, Line &line)
+{
+	const char *src = text;
+	int count = span.end + 1;											//The terminator closes the last token
+	int buf = 0, buf_length = 0;
 	char prev = '\n';
-	String buf = "";
-	Line line;
-	for (int c = 0; c < txt.length(); c++)
+
+	for (int c = start; c < count; c++)
 	{
-		char kar = txt[c];
+		char kar = c < span.end ? src[c] : span.terminator;
+		char next = c + 1 < span.end ? src[c + 1] : '\0';
 
 		bool prevdot = prev == '.';
 		bool thisdot = kar == '.';
 
 		bool prevnumber = StringUtils::IsNumber(prev);
 		bool thisnumber = StringUtils::IsNumber(kar);
-		
+
 		bool prevletter = StringUtils::IsLetter(prev) || prevnumber || (thisdot && thisnumber) || (prevdot && thisnumber);
 		bool thisletter = StringUtils::IsLetter(kar) || thisnumber || (thisdot && prevnumber) || (prevdot && thisnumber);
 
@@ -136,56 +225,75 @@ Line Lexer::SplitLine(const String &txt)
 
 		if (thisdot && !StringUtils::IsNumber(prev))
 		{
-			line.strings.push_back(buf);
-			buf = ".";
-			line.strings.push_back(buf);
-			buf = "";
+			AddToken(line, buf, buf_length);
+			AddToken(line, c, 1);
+			buf_length = 0;
 			prev = kar;
 			continue;
 		}
 
-		if (kar == '/' && txt[c + 1] == '/')
-			return line;
+		if (kar == '/' && next == '/')
+			return;
 
 		if (kar == '\t')
-			line.strings.push_back("\t");
+			AddToken(line, c, 1);
 		else if (kar == '"')																	//Fill String
 		{
-			if (buf != "")
-				line.strings.push_back(buf);
+			if (buf_length > 0)
+				AddToken(line, buf, buf_length);
 
-			buf = "\"";
-			for (c++; c < txt.length(); c++)
-				if (txt[c] != '"')
-					buf += txt[c];
-				else break;
+			int open = c;
+			for (c++; c < count; c++)
+				if ((c < span.end ? src[c] : span.terminator) == '"')
+					break;
+
+			if (c < count)
+				AddToken(line, open, c - open + 1);
+			else																				//Unterminated, closed at the end of the line
+				line.tokens.push_back(Token(store(String(src + open, span.end - open) + span.terminator + "\""), Token::STRING));
 
-			line.strings.push_back(buf + "\"");
-			buf = "";
+			buf_length = 0;
 		}
 		if (prevletter && thisletter)															//Continue filling
-			buf += kar;
+		{
+			if (buf_length == 0)
+				buf = c;
+			buf_length++;
+		}
 		else if (prevop && thisop)																//Check for double operators
 		{
-			line.strings.push_back(special ? buf += kar : buf);
-			if (special)	buf = "";
-			else			buf = kar;
+			if (special)
+			{
+				if (buf_length == 0)
+					buf = c;
+				AddToken(line, buf, buf_length + 1);
+				buf_length = 0;
+			}
+			else
+			{
+				AddToken(line, buf, buf_length);
+				buf = c;
+				buf_length = 1;
+			}
 		}
 		else if ((prevletter && !thisletter) || (prevop && !thisop) || (prevletter && thisop) || (prevdot && thisop))	//End filling
 		{
-			if (buf != "")
+			if (buf_length > 0)
 			{
-				line.strings.push_back(buf);
-				buf = kar;
+				AddToken(line, buf, buf_length);
+				buf = c;
+				buf_length = 1;
 			}
 		}
 		else if ((!prevletter && thisletter) || (!prevop && thisop))							//Start filling
-			buf = kar;
+		{
+			buf = c;
+			buf_length = 1;
+		}
 		else if (!prevletter && !thisletter)													//Pass operator
-			if (kar != '\n'  && kar != ' ' && buf != "")
-				line.strings.push_back(buf);
+			if (kar != '\n' && kar != ' ' && buf_length > 0)
+				AddToken(line, buf, buf_length);
 
 		prev = kar;
 	}
-	return line;
-}
\ No newline at end of file
+}
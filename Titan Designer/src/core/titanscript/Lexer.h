@@ -1,34 +1,51 @@
 #pragma once
 
+#include <list>
 #include <string>
 
 #include "core/Data.h"
 #include "utility/StringUtils.h"
 
+//Splits the source into an indentation based tree of Lines. Lines and tokens
+//are located as offsets into the source, the tokens point into a copy of it.
 class Lexer
 {
 public:
 	Lexer(const String &src);
 
 	void Free();
-	void LexBlock();
-	void GetLines();
 	void Lex();
 
-	Line LexLine(const String &line);
-	Line SplitLine(const String &txt);
-
 	Line root;
-	int index;
 
 private:
-	String source;
+	//a source line without its comment
+	struct LineSpan
+	{
+		int begin;
+		int end;
+		char terminator;		//the '\n' or '\r' that ended the line
+		int number;				//1 based
+	};
 
-	Vector<Line> parentstack;
-	Array<String> lines;
+	void GetLines();
+	void LexBlock();
 
-	Token lasttoken = Token("", 0);
-	Token thistoken = Token("", 0);
+	Line* LexLine(const LineSpan &span);
+	void SplitLine(const LineSpan &span, int start, Line &line);
+	void AddToken(Line &line, int start, int length);
 
-	bool finishedlexing = false;
-};
\ No newline at end of file
+	TokenText store(const String &p_text);
+
+	static int GetTokenType(const char *text, int length);
+	static bool IsKeyword(const char *text, int length);
+
+	String source;
+	const char *text;
+
+	//texts of the tokens when no arena is current
+	std::list<String> stored;
+
+	Array<LineSpan> lines;
+	Vector<Line> parentstack;
+};
@@ -0,0 +1,834 @@
+#include "Optimizer.h"
+
+#include "Executer.h"
+#include "types/MethodMaster.h"
+
+int Optimizer::hoisted_count = 0;
+
+Optimizer::Optimizer()
+{
+	function = NULL;
+}
+
+void Optimizer::optimize(const Line &p_root)
+{
+	for (int c = 0; c < p_root.sub.size(); c++)
+		optimize(p_root.sub[c]);
+}
+
+void Optimizer::optimize(Line *p_line)
+{
+	ScriptNode *node = p_line->node;
+
+	if (node && node->type == ScriptNode::FUNCTIONINIT)
+	{
+		function = reinterpret_cast<FunctionInit*>(node)->block;
+
+		fold(function);
+		hoist(function);
+	}
+	else
+	{
+		function = NULL;
+		p_line->node = fold(node);
+	}
+}
+
+//=========================================================================
+//Folding
+//=========================================================================
+
+void Optimizer::fold(ScriptVector<ScriptNode> &p_nodes)
+{
+	for (int c = 0; c < p_nodes.size(); c++)
+	{
+		int line = p_nodes[c] ? p_nodes[c]->line : 0;
+		ScriptNode *folded = fold(p_nodes[c]);
+
+		if (folded && !folded->line)								//A folded statement keeps its line
+			folded->line = line;
+
+		p_nodes.set(c, folded);
+	}
+}
+
+ScriptNode* Optimizer::fold(ScriptNode *p_node)
+{
+	if (!p_node)
+		return NULL;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		sum->left = fold(sum->left);
+		sum->right = fold(sum->right);
+
+		if (is_constant(sum->left) && is_constant(sum->right))
+			return evaluate(p_node);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		pro->left = fold(pro->left);
+		pro->right = fold(pro->right);
+
+		if (is_constant(pro->left) && is_constant(pro->right))
+		{
+			Variant &right = reinterpret_cast<Constant*>(pro->right)->value;
+
+			//leave integer division by zero to the runtime
+			if (pro->op != Variant::DIVIDE || right.type != Variant::INT || right.i != 0)
+				return evaluate(p_node);
+		}
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	{
+		Comparison *comp = reinterpret_cast<Comparison*>(p_node);
+		comp->left = fold(comp->left);
+		comp->right = fold(comp->right);
+
+		if (is_constant(comp->left) && is_constant(comp->right))
+			return evaluate(p_node);
+		break;
+	}
+
+	case ScriptNode::PARENTHESES:
+	{
+		Parentheses *par = reinterpret_cast<Parentheses*>(p_node);
+		par->node = fold(par->node);
+
+		if (is_constant(par->node))
+			return par->node;
+		break;
+	}
+
+	case ScriptNode::ORIENTATION:
+	{
+		Orientation *o = reinterpret_cast<Orientation*>(p_node);
+		o->right = fold(o->right);
+
+		if (is_constant(o->right))
+			return evaluate(p_node);
+		break;
+	}
+
+	case ScriptNode::NOT:
+	{
+		Not *n = reinterpret_cast<Not*>(p_node);
+		n->right = fold(n->right);
+
+		if (is_constant(n->right))
+			return evaluate(p_node);
+		break;
+	}
+
+	case ScriptNode::CONSTRUCTOR:
+	{
+		Constructor *cstr = reinterpret_cast<Constructor*>(p_node);
+		bool constant = is_value_constructor(cstr);
+
+		fold(cstr->params);
+
+		for (int c = 0; c < cstr->params.size(); c++)
+			constant = constant && is_constant(cstr->params[c]);
+
+		if (constant)
+			return evaluate(p_node);
+		break;
+	}
+
+	case ScriptNode::INIT:
+	{
+		Init *init = reinterpret_cast<Init*>(p_node);
+		init->val = fold(init->val);
+		break;
+	}
+
+	case ScriptNode::MODIFY:
+	{
+		Modify *mod = reinterpret_cast<Modify*>(p_node);
+		mod->val = fold(mod->val);
+		break;
+	}
+
+	case ScriptNode::RETURN:
+	{
+		Return *re = reinterpret_cast<Return*>(p_node);
+		re->val = fold(re->val);
+		break;
+	}
+
+	case ScriptNode::ARRAY_INIT:
+		fold(reinterpret_cast<ArrayInit*>(p_node)->nodes);
+		break;
+
+	case ScriptNode::ARRAY_INDEXING:
+	{
+		ArrayIndexing *indexing = reinterpret_cast<ArrayIndexing*>(p_node);
+		indexing->array = fold(indexing->array);
+		indexing->index = fold(indexing->index);
+		break;
+	}
+
+	case ScriptNode::AND:
+	{
+		And *a = reinterpret_cast<And*>(p_node);
+		a->left = fold(a->left);
+		a->right = fold(a->right);
+		break;
+	}
+
+	case ScriptNode::OR:
+	{
+		Or *o = reinterpret_cast<Or*>(p_node);
+		o->left = fold(o->left);
+		o->right = fold(o->right);
+		break;
+	}
+
+	case ScriptNode::FUNCTIONCALL:
+		fold(reinterpret_cast<FunctionCall*>(p_node)->params);
+		break;
+
+	case ScriptNode::STATICFUNC:
+		fold(reinterpret_cast<StaticFuncCall*>(p_node)->params);
+		break;
+
+	case ScriptNode::SUPERFUNC:
+		fold(reinterpret_cast<SuperFunction*>(p_node)->params);
+		break;
+
+	case ScriptNode::YIELD:
+		fold(reinterpret_cast<Yield*>(p_node)->params);
+		break;
+
+	case ScriptNode::COMPOSITION:
+		fold(reinterpret_cast<Composition*>(p_node)->nodes);
+		break;
+
+	case ScriptNode::PATH:
+	{
+		Path *path = reinterpret_cast<Path*>(p_node);
+		path->origin->node = fold(path->origin->node);
+
+		for (int c = 0; c < path->path.size(); c++)
+			if (path->path[c]->type == ScriptNode::MEMBERFUNC)
+				fold(reinterpret_cast<MemberFunc*>(path->path[c])->args);
+		break;
+	}
+
+	case ScriptNode::IF:
+	{
+		If *ifstat = reinterpret_cast<If*>(p_node);
+
+		for (int c = 0; c < ifstat->elements.size(); c++)
+		{
+			IfElement *e = ifstat->elements[c];
+
+			if (e->branch != IfElement::BRANCH_ELSE)
+				e->passtest = fold(e->passtest);
+
+			fold(e->node);
+		}
+
+		prune(ifstat);
+		break;
+	}
+
+	case ScriptNode::BLOCK:
+		fold(reinterpret_cast<Block*>(p_node)->lines);
+		break;
+
+	case ScriptNode::FOR:
+	{
+		ForLoop *loop = reinterpret_cast<ForLoop*>(p_node);
+		loop->decl = fold(loop->decl);
+		loop->passcheck = fold(loop->passcheck);
+		loop->func = fold(loop->func);
+		loop->update = fold(loop->update);
+		break;
+	}
+
+	case ScriptNode::WHILE:
+	{
+		WhileLoop *loop = reinterpret_cast<WhileLoop*>(p_node);
+		loop->passcheck = fold(loop->passcheck);
+		loop->func = fold(loop->func);
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	return p_node;
+}
+
+ScriptNode* Optimizer::evaluate(ScriptNode *p_node)
+{
+	return new Constant(SimpleExecuter::execute(p_node));
+}
+
+void Optimizer::prune(If *p_if)
+{
+	ScriptVector<IfElement> &elements = p_if->elements;
+
+	for (int c = 0; c < elements.size(); c++)
+	{
+		IfElement *e = elements[c];
+
+		if (e->branch == IfElement::BRANCH_ELSE || !is_constant(e->passtest))
+			continue;
+
+		bool pass = reinterpret_cast<Constant*>(e->passtest)->value;
+
+		if (pass)												//Always taken, the rest is dead
+		{
+			e->branch = IfElement::BRANCH_ELSE;
+			e->passtest = NULL;
+
+			while (elements.size() > c + 1)
+				elements.removelast();
+			break;
+		}
+		else													//Never taken
+			elements.clear(c--);
+	}
+
+	if (elements.size() > 0 && elements[0]->branch == IfElement::BRANCH_ELSEIF)
+		elements[0]->branch = IfElement::BRANCH_IF;
+}
+
+//=========================================================================
+//Hoisting
+//=========================================================================
+
+void Optimizer::hoist(Block *p_block)
+{
+	for (int c = 0; c < p_block->lines.size(); c++)
+	{
+		ScriptNode *line = p_block->lines[c];
+
+		if (!line)
+			continue;
+
+		if (line->type == ScriptNode::WHILE || line->type == ScriptNode::FOR)
+			hoist_loop(line, p_block, c);
+
+		switch (line->type)
+		{
+		case ScriptNode::IF:
+		{
+			If *ifstat = reinterpret_cast<If*>(line);
+
+			for (int i = 0; i < ifstat->elements.size(); i++)
+				hoist(ifstat->elements[i]->node);
+			break;
+		}
+
+		case ScriptNode::WHILE:
+		{
+			WhileLoop *loop = reinterpret_cast<WhileLoop*>(line);
+
+			if (loop->func && loop->func->type == ScriptNode::BLOCK)
+				hoist(reinterpret_cast<Block*>(loop->func));
+			break;
+		}
+
+		case ScriptNode::FOR:
+		{
+			ForLoop *loop = reinterpret_cast<ForLoop*>(line);
+
+			if (loop->func && loop->func->type == ScriptNode::BLOCK)
+				hoist(reinterpret_cast<Block*>(loop->func));
+			break;
+		}
+
+		case ScriptNode::BLOCK:
+			hoist(reinterpret_cast<Block*>(line));
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+void Optimizer::hoist_loop(ScriptNode *p_loop, Block *p_block, int &r_index)
+{
+	written_slots.clear();
+	collect_writes(p_loop);
+
+	if (p_loop->type == ScriptNode::WHILE)
+	{
+		WhileLoop *loop = reinterpret_cast<WhileLoop*>(p_loop);
+		hoist_expression(loop->passcheck, p_block, r_index);
+		hoist_expression(loop->func, p_block, r_index);
+	}
+	else
+	{
+		ForLoop *loop = reinterpret_cast<ForLoop*>(p_loop);
+		hoist_expression(loop->passcheck, p_block, r_index);
+		hoist_expression(loop->func, p_block, r_index);
+		hoist_expression(loop->update, p_block, r_index);
+	}
+}
+
+//only operands of arithmetic and comparisons are hoisted: they are never
+//stored, so sharing one value between iterations cannot be observed
+void Optimizer::hoist_expression(ScriptNode *p_node, Block *p_block, int &r_index)
+{
+	if (!p_node)
+		return;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		sum->left = hoist_operand(sum->left, p_block, r_index);
+		sum->right = hoist_operand(sum->right, p_block, r_index);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		pro->left = hoist_operand(pro->left, p_block, r_index);
+		pro->right = hoist_operand(pro->right, p_block, r_index);
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	{
+		Comparison *comp = reinterpret_cast<Comparison*>(p_node);
+		comp->left = hoist_operand(comp->left, p_block, r_index);
+		comp->right = hoist_operand(comp->right, p_block, r_index);
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	Array<ScriptNode*> children = get_children(p_node);
+
+	for (int c = 0; c < children.size(); c++)
+		hoist_expression(children[c], p_block, r_index);
+}
+
+ScriptNode* Optimizer::hoist_operand(ScriptNode *p_operand, Block *p_block, int &r_index)
+{
+	if (!p_operand || p_operand->type != ScriptNode::CONSTRUCTOR)
+		return p_operand;
+
+	Constructor *cstr = reinterpret_cast<Constructor*>(p_operand);
+
+	//reading a slot shares a boxed value instead of copying it, those are built every iteration
+	if (!is_inline_type(cstr->name) || !is_invariant(cstr))
+		return p_operand;
+
+	//evaluate once into a hidden local in front of the loop
+	StringName name = String("$hoisted") + String(hoisted_count++);
+	int slot = function->slot_count++;
+
+	VariableNode *target = new VariableNode(name);
+	VariableNode *value = new VariableNode(name);
+	target->slot = slot;
+	value->slot = slot;
+
+	p_block->lines.insert(r_index++, new Init(p_operand, target));
+	return value;
+}
+
+void Optimizer::collect_writes(ScriptNode *p_node)
+{
+	if (!p_node)
+		return;
+
+	ScriptNode *target = NULL;
+
+	if (p_node->type == ScriptNode::INIT)
+		target = reinterpret_cast<Init*>(p_node)->var;
+	else if (p_node->type == ScriptNode::MODIFY)
+		target = reinterpret_cast<Modify*>(p_node)->var;
+	else if (p_node->type == ScriptNode::CHANGEONE)
+		target = reinterpret_cast<ChangeOne*>(p_node)->var;
+
+	if (target && target->type == ScriptNode::VARIABLE)
+		written_slots.push_back(reinterpret_cast<VariableNode*>(target)->slot);
+
+	Array<ScriptNode*> children = get_children(p_node);
+
+	for (int c = 0; c < children.size(); c++)
+		collect_writes(children[c]);
+}
+
+//a constructor is invariant when its arguments are constants or locals
+//the loop never assigns; globals may change through any call
+bool Optimizer::is_invariant(Constructor *p_cstr) const
+{
+	if (!function || !is_value_constructor(p_cstr))
+		return false;
+
+	for (int c = 0; c < p_cstr->params.size(); c++)
+	{
+		ScriptNode *param = p_cstr->params[c];
+
+		if (is_constant(param))
+			continue;
+
+		if (!param || param->type != ScriptNode::VARIABLE)
+			return false;
+
+		int slot = reinterpret_cast<VariableNode*>(param)->slot;
+
+		if (slot < 0 || written_slots.contains(slot))
+			return false;
+	}
+
+	return true;
+}
+
+//=========================================================================
+//Helpers
+//=========================================================================
+
+bool Optimizer::is_constant(ScriptNode *p_node)
+{
+	return p_node && p_node->type == ScriptNode::CONSTANT;
+}
+
+//constructors of value types have no side effects, objects are never folded or shared
+bool Optimizer::is_value_constructor(Constructor *p_cstr)
+{
+	VariantType type = VariantType(p_cstr->name);
+
+	return !type.is_object_type() && MMASTER->get_constructor(type, p_cstr->params.size());
+}
+
+//vec2, vec3, vec4 and Color, the types a Variant stores without a heap box
+bool Optimizer::is_inline_type(const StringName &p_name)
+{
+	return p_name == "vec2" || p_name == "vec3" || p_name == "vec4" || p_name == "Color";
+}
+
+Array<ScriptNode*> Optimizer::get_children(ScriptNode *p_node)
+{
+	Array<ScriptNode*> children;
+
+	if (!p_node)
+		return children;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::INIT:
+	{
+		Init *init = reinterpret_cast<Init*>(p_node);
+		children.push_back(init->val);
+		children.push_back(init->var);
+		break;
+	}
+
+	case ScriptNode::MODIFY:
+	{
+		Modify *mod = reinterpret_cast<Modify*>(p_node);
+		children.push_back(mod->val);
+		children.push_back(mod->var);
+		break;
+	}
+
+	case ScriptNode::CHANGEONE:
+		children.push_back(reinterpret_cast<ChangeOne*>(p_node)->var);
+		break;
+
+	case ScriptNode::ARRAY_INIT:
+		for (ScriptNode *n : reinterpret_cast<ArrayInit*>(p_node)->nodes)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::ARRAY_INDEXING:
+	{
+		ArrayIndexing *indexing = reinterpret_cast<ArrayIndexing*>(p_node);
+		children.push_back(indexing->array);
+		children.push_back(indexing->index);
+		break;
+	}
+
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		children.push_back(sum->left);
+		children.push_back(sum->right);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		children.push_back(pro->left);
+		children.push_back(pro->right);
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	{
+		Comparison *comp = reinterpret_cast<Comparison*>(p_node);
+		children.push_back(comp->left);
+		children.push_back(comp->right);
+		break;
+	}
+
+	case ScriptNode::AND:
+	{
+		And *a = reinterpret_cast<And*>(p_node);
+		children.push_back(a->left);
+		children.push_back(a->right);
+		break;
+	}
+
+	case ScriptNode::OR:
+	{
+		Or *o = reinterpret_cast<Or*>(p_node);
+		children.push_back(o->left);
+		children.push_back(o->right);
+		break;
+	}
+
+	case ScriptNode::PARENTHESES:
+		children.push_back(reinterpret_cast<Parentheses*>(p_node)->node);
+		break;
+
+	case ScriptNode::IF:
+		for (IfElement *e : reinterpret_cast<If*>(p_node)->elements)
+			children.push_back(e);
+		break;
+
+	case ScriptNode::IFELEMENT:
+	{
+		IfElement *e = reinterpret_cast<IfElement*>(p_node);
+
+		if (e->branch != IfElement::BRANCH_ELSE)
+			children.push_back(e->passtest);
+
+		children.push_back(e->node);
+		break;
+	}
+
+	case ScriptNode::BLOCK:
+		for (ScriptNode *n : reinterpret_cast<Block*>(p_node)->lines)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::FUNCTIONINIT:
+		children.push_back(reinterpret_cast<FunctionInit*>(p_node)->block);
+		break;
+
+	case ScriptNode::FUNCTIONCALL:
+		for (ScriptNode *n : reinterpret_cast<FunctionCall*>(p_node)->params)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::STATICFUNC:
+		for (ScriptNode *n : reinterpret_cast<StaticFuncCall*>(p_node)->params)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::SUPERFUNC:
+		for (ScriptNode *n : reinterpret_cast<SuperFunction*>(p_node)->params)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::CONSTRUCTOR:
+		for (ScriptNode *n : reinterpret_cast<Constructor*>(p_node)->params)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::YIELD:
+		for (ScriptNode *n : reinterpret_cast<Yield*>(p_node)->params)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::RETURN:
+		children.push_back(reinterpret_cast<Return*>(p_node)->val);
+		break;
+
+	case ScriptNode::FOR:
+	{
+		ForLoop *loop = reinterpret_cast<ForLoop*>(p_node);
+		children.push_back(loop->decl);
+		children.push_back(loop->passcheck);
+		children.push_back(loop->func);
+		children.push_back(loop->update);
+		break;
+	}
+
+	case ScriptNode::WHILE:
+	{
+		WhileLoop *loop = reinterpret_cast<WhileLoop*>(p_node);
+		children.push_back(loop->passcheck);
+		children.push_back(loop->func);
+		break;
+	}
+
+	case ScriptNode::COMPOSITION:
+		for (ScriptNode *n : reinterpret_cast<Composition*>(p_node)->nodes)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::PATH:
+	{
+		Path *path = reinterpret_cast<Path*>(p_node);
+		children.push_back(path->origin->node);
+
+		for (ScriptNode *n : path->path)
+			children.push_back(n);
+		break;
+	}
+
+	case ScriptNode::MEMBERFUNC:
+		for (ScriptNode *n : reinterpret_cast<MemberFunc*>(p_node)->args)
+			children.push_back(n);
+		break;
+
+	case ScriptNode::ORIENTATION:
+		children.push_back(reinterpret_cast<Orientation*>(p_node)->right);
+		break;
+
+	case ScriptNode::NOT:
+		children.push_back(reinterpret_cast<Not*>(p_node)->right);
+		break;
+
+	default:
+		break;
+	}
+
+	return children;
+}
+
+//=========================================================================
+//Dump
+//=========================================================================
+
+String Optimizer::dump(const Line &p_root)
+{
+	String result;
+
+	for (int c = 0; c < p_root.sub.size(); c++)
+		if (p_root.sub[c]->node)
+			dump(p_root.sub[c]->node, 0, result);
+
+	return result;
+}
+
+void Optimizer::dump(ScriptNode *p_node, int p_depth, String &r_result)
+{
+	r_result += String("\t") * p_depth + describe(p_node) + "\n";
+
+	Array<ScriptNode*> children = get_children(p_node);
+
+	for (int c = 0; c < children.size(); c++)
+		dump(children[c], p_depth + 1, r_result);
+}
+
+String Optimizer::describe(ScriptNode *p_node)
+{
+	static const char *type_names[] =
+	{
+		"Undef", "Constant", "Extends",
+		"Init", "ArrayInit", "Value", "Sum",
+		"Product", "Parentheses", "If",
+		"IfElement", "And", "Or",
+		"Variable", "ArrayIndexing", "FunctionInit",
+		"Block", "FunctionCall", "Return", "While",
+		"For", "Composition", "Comparison",
+		"ChangeOne", "Modify", "Path",
+		"PathOrigin", "Orientation", "Not",
+		"StaticFunc", "StaticVar", "SuperVar",
+		"SuperFunc", "MemberFunc", "MemberVar",
+		"Constructor", "TypeSpecifier", "Yield"
+	};
+	static const char operators[] = { '+', '-', '*', '/' };
+	static const char *comparisons[] = { "<", "<=", "==", "!=", ">", ">=" };
+
+	if (!p_node)
+		return "null";
+
+	String result = type_names[p_node->type];
+
+	switch (p_node->type)
+	{
+	case ScriptNode::CONSTANT:
+		result += " " + reinterpret_cast<Constant*>(p_node)->value.ToString();
+		break;
+
+	case ScriptNode::VARIABLE:
+	{
+		VariableNode *var = reinterpret_cast<VariableNode*>(p_node);
+		result += " " + var->name.get_source();
+
+		if (var->slot >= 0)
+			result += " [slot " + String(var->slot) + "]";
+		break;
+	}
+
+	case ScriptNode::SUM:
+		result += String(" ") + operators[reinterpret_cast<Sum*>(p_node)->op];
+		break;
+
+	case ScriptNode::PRODUCT:
+		result += String(" ") + operators[reinterpret_cast<Product*>(p_node)->op];
+		break;
+
+	case ScriptNode::MODIFY:
+		result += String(" ") + operators[reinterpret_cast<Modify*>(p_node)->op] + "=";
+		break;
+
+	case ScriptNode::COMPARISON:
+		result += String(" ") + comparisons[reinterpret_cast<Comparison*>(p_node)->eval];
+		break;
+
+	case ScriptNode::BLOCK:
+		result += " [" + String(reinterpret_cast<Block*>(p_node)->slot_count) + " slots]";
+		break;
+
+	case ScriptNode::FUNCTIONINIT:
+		result += " " + reinterpret_cast<FunctionInit*>(p_node)->name.get_source();
+		break;
+
+	case ScriptNode::FUNCTIONCALL:
+		result += " " + reinterpret_cast<FunctionCall*>(p_node)->name.get_source();
+		break;
+
+	case ScriptNode::STATICFUNC:
+		result += " " + reinterpret_cast<StaticFuncCall*>(p_node)->name.get_source();
+		break;
+
+	case ScriptNode::SUPERFUNC:
+		result += " " + reinterpret_cast<SuperFunction*>(p_node)->name.get_source();
+		break;
+
+	case ScriptNode::CONSTRUCTOR:
+		result += " " + reinterpret_cast<Constructor*>(p_node)->name.get_source();
+		break;
+
+	case ScriptNode::MEMBERFUNC:
+		result += " " + reinterpret_cast<MemberFunc*>(p_node)->method_name.get_source();
+		break;
+
+	case ScriptNode::MEMBERVAR:
+		result += " " + reinterpret_cast<MemberVar*>(p_node)->variable_name.get_source();
+		break;
+
+	default:
+		break;
+	}
+
+	return result;
+}
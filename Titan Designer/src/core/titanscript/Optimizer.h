@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core/Data.h"
+
+//Optimization pass between the Parser and the Executer:
+//folds constant subtrees, prunes if-branches with a constant test and hoists
+//loop invariant value constructors out of the loops inside functions
+class Optimizer
+{
+public:
+	Optimizer();
+
+	void optimize(const Line &p_root);
+
+	//optimizes a single top level line, used when reloading
+	void optimize(Line *p_line);
+
+	//readable dump of the tree, one node per line
+	static String dump(const Line &p_root);
+
+	//direct children of a node, statements and expressions alike
+	static Array<ScriptNode*> get_children(ScriptNode *p_node);
+
+private:
+	//returns the node that replaces p_node
+	ScriptNode* fold(ScriptNode *p_node);
+	void fold(ScriptVector<ScriptNode> &p_nodes);
+	ScriptNode* evaluate(ScriptNode *p_node);
+	void prune(If *p_if);
+
+	void hoist(Block *p_block);
+	void hoist_loop(ScriptNode *p_loop, Block *p_block, int &r_index);
+	void hoist_expression(ScriptNode *p_node, Block *p_block, int &r_index);
+	ScriptNode* hoist_operand(ScriptNode *p_operand, Block *p_block, int &r_index);
+	void collect_writes(ScriptNode *p_node);
+
+	bool is_invariant(Constructor *p_cstr) const;
+	static bool is_constant(ScriptNode *p_node);
+	static bool is_value_constructor(Constructor *p_cstr);
+	static bool is_inline_type(const StringName &p_name);
+
+	static String describe(ScriptNode *p_node);
+	static void dump(ScriptNode *p_node, int p_depth, String &r_result);
+
+	Block *function;
+	Array<int> written_slots;
+
+	//shared so the hidden names stay unique when lines are optimized separately
+	static int hoisted_count;
+};
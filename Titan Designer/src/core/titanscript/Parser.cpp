@@ -3,6 +3,33 @@
 #include "core/Array.h"
 #include "types/MethodMaster.h"
 #include "Executer.h"
+#include "Resolver.h"
+#include "Optimizer.h"
+
+//words the Parser looks for, compared with the interned names of the tokens
+struct Keywords
+{
+	StringName if_branch = "if";
+	StringName else_branch = "else";
+	StringName elseif_branch = "elseif";
+	StringName define = "define";
+	StringName extends = "extends";
+	StringName while_loop = "while";
+	StringName for_loop = "for";
+	StringName func = "func";
+	StringName return_value = "return";
+	StringName yield = "yield";
+	StringName true_value = "true";
+	StringName false_value = "false";
+	StringName wait = "wait";
+	StringName wait_signal = "wait_signal";
+};
+
+static const Keywords& keywords()
+{
+	static Keywords names;
+	return names;
+}
 
 Parser::Parser(State *_state, Line &root)
 {
@@ -15,10 +42,28 @@ void Parser::Parse(Line &root)
 {
 	//StaticFunctions::Init();
 	for (int c = 0; c < root.sub.size(); c++)
-		root.sub[c]->node = ParsePart(*root.sub[c]);
+		parse_line(root, c);
+
+	Resolver().resolve(root);
+	Optimizer().optimize(root);
+}
+
+ScriptNode* Parser::parse_line(Line &p_root, int p_index)
+{
+	//else and elseif lines are found through the parent of the if
+	parent = &p_root;
+	subindex = p_index;
+
+	ScriptNode *node = ParsePart(*p_root.sub[p_index]);
+
+	if (node)
+		node->line = p_root.sub[p_index]->number;
+
+	p_root.sub[p_index]->node = node;
+	return node;
 }
 
-int Parser::GetFirstIndex(const Array<Token> &tokens, const String src[], int srccount)
+int Parser::GetFirstIndex(const TokenArray &tokens, const String src[], int srccount)
 {
 	int ind = -1, level = 0;
 	for (int c = 0; c < tokens.size(); c++)
@@ -42,8 +87,8 @@ Composition* Parser::GetComposition(const Line &line)
 		return new Composition;
 
 	Composition *comp = new Composition;
-	Array<Token> buf;
-	Array<Array<Token>> bufs;
+	TokenArray buf;
+	Array<TokenArray> bufs;
 	int level = 0;
 
 	for (int c = 0; c < line.tokens.size(); c++)
@@ -83,7 +128,12 @@ Block* Parser::ParseBlock(const Line &line)
 	for (int c = 0; c < count; c++)
 	{
 		subindex = c;
-		nodes.push_back(ParsePart(*l.sub[c]));
+		ScriptNode *node = ParsePart(*l.sub[c]);
+
+		if (node)
+			node->line = l.sub[c]->number;
+
+		nodes.push_back(node);
 	}
 
 	return new Block(nodes);
@@ -91,34 +141,34 @@ Block* Parser::ParseBlock(const Line &line)
 
 ScriptNode* Parser::ParsePart(const Line &line)
 {
-	if (line.StartsWith("else"))
+	if (line.StartsWithName(keywords().else_branch))
 		return NULL;
-	else if (line.StartsWith("elseif"))
+	else if (line.StartsWithName(keywords().elseif_branch))
 		return NULL;
-	else if (line.StartsWith("define"))
+	else if (line.StartsWithName(keywords().define))
 	{
 		ScriptNode *node = ParsePart(line.tokens.getrest(2));
 
-		StringName name = line.tokens[1].text;
+		StringName name = line.tokens[1].name;
 		Variant value = SimpleExecuter::execute(node);
 
 		definitions.push_back({ name, value });
 		return NULL;
 	}
-	else if (line.StartsWith("extends"))															//Inheritance
+	else if (line.StartsWithName(keywords().extends))															//Inheritance
 	{
-		Extends *e = new Extends(line.tokens[1].text);
-		state->extensiontype = GETTYPE(StringName(line.tokens[1].text));
+		Extends *e = new Extends(line.tokens[1].name);
+		state->extensiontype = GETTYPE(line.tokens[1].name);
 		return e;
 	}
-	else if (line.StartsWith("while"))																//While Loop
+	else if (line.StartsWithName(keywords().while_loop))																//While Loop
 	{
 		WhileLoop *loop = new WhileLoop;
 		loop->passcheck = ParsePart(line.tokens.getrest(1));
 		loop->func = ParseBlock(line);
 		return loop;
 	}
-	else if (line.StartsWith("for"))																//For Loop
+	else if (line.StartsWithName(keywords().for_loop))																//For Loop
 	{
 		ForLoop *loop = new ForLoop;
 		loop->func = ParseBlock(line);
@@ -160,7 +210,7 @@ ScriptNode* Parser::ParsePart(const Line &line)
 
 		return init;
 	}
-	else if (line.StartsWith("func"))																//Init Func
+	else if (line.StartsWithName(keywords().func))																//Init Func
 	{
 		FunctionInit *init = new FunctionInit;
 		Block* node = new Block;
@@ -178,25 +228,28 @@ ScriptNode* Parser::ParsePart(const Line &line)
 		for (ScriptNode *n : comp->nodes)
 			node->params.push_back(n);
 
-		init->name = StringName(line.tokens[1].text);
+		init->name = line.tokens[1].name;
 		init->block = ParseBlock(line);
 		init->block->params = node->params;
 		init->block->isfunction = true;
 
 		return init;
 	}
-	else if (line.StartsWith("if"))																	//If
+	else if (line.StartsWithName(keywords().if_branch))																	//If
 	{
 		If *ifstat = new If;
 		IfElement *e;
 		Line l = line, par = *parent;
 		int index = subindex;
 
-		while ((l.StartsWith("if") && ifstat->elements.size() == 0) || l.StartsWith("elseif") || l.StartsWith("else")) //Line must begin with if, elseif, else
+		while ((l.StartsWithName(keywords().if_branch) && ifstat->elements.size() == 0) || l.StartsWithName(keywords().elseif_branch) || l.StartsWithName(keywords().else_branch)) //Line must begin with if, elseif, else
 		{
 			e = new IfElement;
-			e->name = StringName(l.tokens[0].text);
-			if (!l.StartsWith("else"))
+			if (l.StartsWithName(keywords().if_branch))				e->branch = IfElement::BRANCH_IF;
+			else if (l.StartsWithName(keywords().elseif_branch))	e->branch = IfElement::BRANCH_ELSEIF;
+			else								e->branch = IfElement::BRANCH_ELSE;
+
+			if (!l.StartsWithName(keywords().else_branch))
 				e->passtest = ParsePart(l.tokens.getrest(1));
 			e->node = ParseBlock(l);
 			ifstat->elements.push_back(e);
@@ -207,25 +260,30 @@ ScriptNode* Parser::ParsePart(const Line &line)
 		}
 		return ifstat;
 	}
-	else if (line.StartsWith("return"))																//Return
+	else if (line.StartsWithName(keywords().return_value))																//Return
 	{
 		Return *re = new Return;
 		if (line.tokens.size() > 1)
 			re->val = ParsePart(line.tokens.getrest(1));
 		return re;
 	}
+	else if (line.StartsWithName(keywords().yield) && line.size() == 1)											//Yield
+	{
+		return new Yield;
+	}
 	else if (line.ContainsOutside("+=") || line.ContainsOutside("-=") ||
 		line.ContainsOutside("*=") || line.ContainsOutside("/="))									//Modify
 	{
 		Modify *mod = new Modify;
+		String op;
 
-		if (line.ContainsOutside("+="))			mod->op = String("+=");
-		else if (line.ContainsOutside("-="))	mod->op = "-=";
-		else if (line.ContainsOutside("*="))	mod->op = "*=";
-		else									mod->op = "/=";
+		if (line.ContainsOutside("+="))			{ op = "+="; mod->op = Variant::ADD; }
+		else if (line.ContainsOutside("-="))	{ op = "-="; mod->op = Variant::SUBTRACT; }
+		else if (line.ContainsOutside("*="))	{ op = "*="; mod->op = Variant::MULTIPLY; }
+		else									{ op = "/="; mod->op = Variant::DIVIDE; }
 
-		mod->val = ParsePart(line.tokens.getrest(line.Search(mod->op) + 1));
-		mod->var = ParsePart(line.tokens.split(0, line.Search(mod->op) - 1));
+		mod->val = ParsePart(line.tokens.getrest(line.Search(op) + 1));
+		mod->var = ParsePart(line.tokens.split(0, line.Search(op) - 1));
 		return mod;
 	}
 	else if (line.ContainsOutside(","))																//Composition
@@ -235,10 +293,10 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	else if (line.StartsWith("-") || line.StartsWith("+"))											//Orientation
 	{
 		Orientation *o = new Orientation;
-		Array<Token> ts;
+		TokenArray ts;
 		ts.push_back(line.tokens.split(1, line.tokens.size() - 1));
 		o->right = ParsePart(ts);
-		o->o = line.tokens[0].text[0];
+		o->negate = line.tokens[0].text == "-";
 
 		return o;
 	}
@@ -248,12 +306,12 @@ ScriptNode* Parser::ParsePart(const Line &line)
 		String arr[] = { "+", "-" };
 		int ind = GetFirstIndex(line.tokens, arr, 2);
 
-		sum->op = line.tokens[ind].text;
+		sum->op = line.tokens[ind].text == "+" ? Variant::ADD : Variant::SUBTRACT;
 
-		if (line.Search(sum->op) > 0)
-			sum->left = ParsePart(line.tokens.split(0, line.Search(sum->op) - 1));
+		if (ind > 0)
+			sum->left = ParsePart(line.tokens.split(0, ind - 1));
 
-		sum->right = ParsePart(line.tokens.getrest(line.Search(sum->op) + 1));
+		sum->right = ParsePart(line.tokens.getrest(ind + 1));
 		return sum;
 	}
 	else if (line.ContainsOutside("*") || line.ContainsOutside("/"))								//Product
@@ -262,12 +320,12 @@ ScriptNode* Parser::ParsePart(const Line &line)
 		String arr[] = { "*", "/" };
 		int ind = GetFirstIndex(line.tokens, arr, 2);
 
-		pro->op = String(line.tokens[ind].text);
+		pro->op = line.tokens[ind].text == "*" ? Variant::MULTIPLY : Variant::DIVIDE;
 
-		if (line.Search(pro->op) > 0)
-			pro->left = ParsePart(line.tokens.split(0, line.Search(pro->op) - 1));
+		if (ind > 0)
+			pro->left = ParsePart(line.tokens.split(0, ind - 1));
 
-		pro->right = ParsePart(line.tokens.getrest(line.Search(pro->op) + 1));
+		pro->right = ParsePart(line.tokens.getrest(ind + 1));
 		return pro;
 	}
 	else if (line.ContainsOutside("&&"))															//And
@@ -290,10 +348,15 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	{
 		Comparison *comp = new Comparison;
 		const String arr[] = { "<=", ">=", "==", "!=", ">", "<" };
+		const Variant::EvaluationType evals[] = { Variant::LEQUAL, Variant::GEQUAL, Variant::EQUAL, Variant::NOTEQUAL, Variant::GREATER, Variant::LESS };
 		int ind = GetFirstIndex(line.tokens, arr, 6);
-		comp->name = line.tokens[ind].text;
-		comp->left = ParsePart(line.tokens.split(0, line.Search(comp->name) - 1));
-		comp->right = ParsePart(line.tokens.getrest(line.Search(comp->name) + 1));
+
+		for (int c = 0; c < 6; c++)
+			if (line.tokens[ind].text == arr[c])
+				comp->eval = evals[c];
+
+		comp->left = ParsePart(line.tokens.split(0, ind - 1));
+		comp->right = ParsePart(line.tokens.getrest(ind + 1));
 		return comp;
 	}
 	else if (line.StartsWith("("))																	//Parentheses
@@ -314,21 +377,33 @@ ScriptNode* Parser::ParsePart(const Line &line)
 		Variant val = Variant(new Real(line.tokens[0].text));
 		return new Constant(val);
 	}
-	else if ((line.StartsWith("true") || line.StartsWith("false")) && line.size() == 1)				//bool keyword
+	else if ((line.StartsWithName(keywords().true_value) || line.StartsWithName(keywords().false_value)) && line.size() == 1)				//bool keyword
 	{
 		Variant val = (bool)String(line.tokens[0].text);
 		return new Constant(val);
 	}
 	else if (line.StartsWith(Token::WORD) && line.size() > 1 && line.tokens[1].text == "(" &&  line.SearchOutside(")") == line.tokens.size() - 1)			//Function Call
 	{
-		String name = line.tokens[0].text;
-		StringName sname = name;
+		StringName sname = line.tokens[0].name;
 
 		//The arguments
 		Line l = Line(line.tokens.split(2, line.tokens.size() - 2));
 		Composition *comp = GetComposition(l);
 
-		if (MMASTER->static_funcs.contains(sname))													//Static Function
+		if (sname == keywords().wait || sname == keywords().wait_signal)							//Wait
+		{
+			Yield *y = new Yield;
+			y->wait = sname == keywords().wait ? Yield::WAIT_SECONDS : Yield::WAIT_SIGNAL;
+
+			for (ScriptNode *n : comp->nodes)
+				y->params.push_back(n);
+
+			if (y->params.size() != (y->wait == Yield::WAIT_SECONDS ? 1 : 2))
+				PARSE_ERROR("Wrong number of arguments for: " + sname.get_source());
+
+			return y;
+		}
+		else if (MMASTER->static_funcs.contains(sname))													//Static Function
 		{
 			StaticFuncCall *sfc = new StaticFuncCall;
 			sfc->name = sname;
@@ -372,9 +447,9 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	else if (line.EndsWith("++") || line.EndsWith("--"))											//Add or subtract one
 	{
 		ChangeOne *one = new ChangeOne;
-		one->op = line.tokens[line.tokens.size() - 1].text;
+		one->op = line.tokens[line.tokens.size() - 1].text == "--" ? Variant::SUBTRACT : Variant::ADD;
 
-		Array<Token> ts = line.tokens.split(0, line.tokens.size() - 2);
+		TokenArray ts = line.tokens.split(0, line.tokens.size() - 2);
 		one->var = ParsePart(ts);
 		return one;
 	}
@@ -393,9 +468,16 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	else if (line.StartsWith(Token::WORD))															//Variable
 	{
 		//Concatenate strings to create name
-		String name;
-		for (int c = 0; c < line.tokens.size(); c++)
-			name += line.tokens[c].text;
+		StringName name = line.tokens[0].name;
+
+		if (line.size() > 1)
+		{
+			String path;
+			for (int c = 0; c < line.tokens.size(); c++)
+				path += String(line.tokens[c].text);
+
+			name = path;
+		}
 
 		//Is it a static variable?
 		Definition *def = get_definition(name);
@@ -403,21 +485,21 @@ ScriptNode* Parser::ParsePart(const Line &line)
 			return new Constant(def->value);
 
 		//Is it a member variable? 
-		else if (!line.ContainsOutside(".") && MethodMaster::get_method_master()->property_exists(VariantType(state->extensiontype), StringName(line.tokens[0].text)))
+		else if (!line.ContainsOutside(".") && MethodMaster::get_method_master()->property_exists(VariantType(state->extensiontype), line.tokens[0].name))
 		{
 			SuperVariable *super_var = new SuperVariable;
 			super_var->property = MethodMaster::get_method_master()->get_property(
-				VariantType(state->extensiontype), StringName(line.tokens[0].text));
+				VariantType(state->extensiontype), line.tokens[0].name);
 			return super_var;
 		}
 
 		//Is it a simple single variable or a type specifier?
 		if (!line.ContainsOutside("."))
 		{
-			if (TYPEMAN->type_exists(line.tokens[0].text))
-				return new TypeSpecifier(TYPEMAN->get_type(line.tokens[0].text));
+			if (TYPEMAN->type_exists(line.tokens[0].name))
+				return new TypeSpecifier(TYPEMAN->get_type(line.tokens[0].name));
 			else
-				return new VariableNode(line.tokens[0].text);
+				return new VariableNode(line.tokens[0].name);
 		}
 
 		//It is more complicated		
@@ -426,7 +508,7 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	else if (line.StartsWith("!"))																	//Not
 	{
 		Not *n = new Not;
-		Array<Token> ts;
+		TokenArray ts;
 		ts.push_back(line.tokens[1]);
 		n->right = ParsePart(ts);
 
@@ -435,8 +517,7 @@ ScriptNode* Parser::ParsePart(const Line &line)
 	else if (line.tokens[0].text[0] == '"' && line.tokens[0].text[line.tokens[0].text.length() - 1] == '"')			//String
 	{
 		String txt(line.tokens[0].text.substr(1, line.tokens[0].text.length() - 2));
-		Variant var = new String(txt);
-		Constant *v = new Constant(var);
+		Constant *v = new Constant(txt);
 		return v;
 	}
 	PARSE_ERROR("Unrecognized statement found while parsing");
@@ -476,7 +557,7 @@ ScriptNode *Parser::ParseMember(const Line &line)
 ScriptNode *Parser::ParseMemberFunc(const Line &line)
 {
 	MemberFunc *call = new MemberFunc;
-	String name = line.tokens[0].text;
+	StringName name = line.tokens[0].name;
 	Line l = Line(line.tokens.split(2, line.tokens.size() - 2));
 	Composition *comp = GetComposition(l);
 
@@ -498,7 +579,7 @@ ScriptNode *Parser::ParseMemberFunc(const Line &line)
 ScriptNode *Parser::ParseMemberVar(const Line &line)
 {
 	MemberVar *mem_var = new MemberVar;
-	String name = line.tokens[0].text;
+	StringName name = line.tokens[0].name;
 	
 	mem_var->variable_name = name;
 
@@ -7,14 +7,31 @@
 #define PARSE_ERROR(X) report_error(ParseError(X, __FILE__, __LINE__));
 #define PARSE_WARNING(X) report_warning(ParseWarning(X, __FILE__, __LINE__));
 
-struct ParseError : public TError
+//kept by the Parser, and logged like T_ERROR and T_WARNING
+struct ParseError : public TMessage
 {
-	ParseError(const String &p_description, const String &p_file_name, int p_line_number) : TError(p_description, p_file_name, p_line_number) { }
+	ParseError(const String &p_description, const char *p_file_name, int p_line_number)
+	{
+		type = T_ERROR;
+		description = p_description;
+		file_name = p_file_name;
+		line_number = p_line_number;
+
+		MessageHandler::log(type, description, p_file_name, line_number);
+	}
 };
 
-struct ParseWarning : public TWarning
+struct ParseWarning : public TMessage
 {
-	ParseWarning(const String &p_description, const String &p_file_name, int p_line_number) : TWarning(p_description, p_file_name, p_line_number) { }
+	ParseWarning(const String &p_description, const char *p_file_name, int p_line_number)
+	{
+		type = T_WARNING;
+		description = p_description;
+		file_name = p_file_name;
+		line_number = p_line_number;
+
+		MessageHandler::log(type, description, p_file_name, line_number);
+	}
 };
 
 class Parser
@@ -22,7 +39,11 @@ class Parser
 public:
 	Parser(State *_state, Line &line);
 	void Parse(Line &line);
-	int GetFirstIndex(const Array<Token> &tokens, const String src[], int srccount);
+
+	//parses one top level line of p_root into its node
+	ScriptNode* parse_line(Line &p_root, int p_index);
+
+	int GetFirstIndex(const TokenArray &tokens, const String src[], int srccount);
 	Composition* GetComposition(const Line &line);
 	Block* ParseBlock(const Line &line);
 
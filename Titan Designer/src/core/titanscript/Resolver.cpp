@@ -0,0 +1,299 @@
+#include "Resolver.h"
+
+#define GLOBAL_SCOPE -1
+#define SHARED_SCOPE -2
+
+Resolver::Resolver()
+{
+	mode = COLLECT_SCOPES;
+	scope = GLOBAL_SCOPE;
+}
+
+void Resolver::resolve(const Line &p_root)
+{
+	mode = COLLECT_SCOPES;
+
+	for (int c = 0; c < p_root.sub.size(); c++)
+	{
+		ScriptNode *node = p_root.sub[c]->node;
+
+		if (!node)
+			continue;
+
+		if (node->type == ScriptNode::FUNCTIONINIT)
+		{
+			Block *block = reinterpret_cast<FunctionInit*>(node)->block;
+			scope = c;
+
+			visit(block->params);
+			visit(block);
+		}
+		else
+		{
+			scope = GLOBAL_SCOPE;
+			visit(node);
+		}
+	}
+
+	for (int c = 0; c < p_root.sub.size(); c++)
+	{
+		ScriptNode *node = p_root.sub[c]->node;
+
+		if (node && node->type == ScriptNode::FUNCTIONINIT)
+			resolve_function(reinterpret_cast<FunctionInit*>(node)->block, c);
+	}
+}
+
+void Resolver::resolve_function(Block *p_block, int p_scope)
+{
+	scope = p_scope;
+	first_write.clear();
+	slots.clear();
+
+	mode = COLLECT_LOCALS;
+	visit(p_block);
+
+	int slot_count = 0;
+
+	for (int c = 0; c < p_block->params.size(); c++)			//Parameters take the first slots
+	{
+		ScriptNode *param = p_block->params[c];
+
+		if (param->type == ScriptNode::VARIABLE)
+			slots.set(reinterpret_cast<VariableNode*>(param)->name, slot_count);
+
+		slot_count++;
+	}
+
+	for (std::pair<const StringName, bool> &use : first_write)
+		if (use.second && scopes[use.first] == p_scope && !slots.contains(use.first))
+			slots.set(use.first, slot_count++);
+
+	mode = ASSIGN_SLOTS;
+	visit(p_block->params);
+	visit(p_block);
+
+	p_block->slot_count = slot_count;
+}
+
+void Resolver::visit(const ScriptVector<ScriptNode> &p_nodes)
+{
+	for (int c = 0; c < p_nodes.size(); c++)
+		visit(p_nodes[c]);
+}
+
+void Resolver::visit_store(ScriptNode *p_target)
+{
+	if (p_target && p_target->type == ScriptNode::VARIABLE)
+		reference(reinterpret_cast<VariableNode*>(p_target), true);
+	else
+		visit(p_target);
+}
+
+//visits the children of a node in the order the Executer evaluates them
+void Resolver::visit(ScriptNode *p_node)
+{
+	if (!p_node)
+		return;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::VARIABLE:
+		reference(reinterpret_cast<VariableNode*>(p_node), false);
+		break;
+
+	case ScriptNode::INIT:
+	{
+		Init *init = reinterpret_cast<Init*>(p_node);
+		visit(init->val);
+		visit_store(init->var);
+		break;
+	}
+
+	case ScriptNode::MODIFY:
+	{
+		Modify *mod = reinterpret_cast<Modify*>(p_node);
+		visit(mod->val);
+		visit(mod->var);
+		visit_store(mod->var);
+		break;
+	}
+
+	case ScriptNode::CHANGEONE:
+	{
+		ChangeOne *one = reinterpret_cast<ChangeOne*>(p_node);
+		visit(one->var);
+		visit_store(one->var);
+		break;
+	}
+
+	case ScriptNode::ARRAY_INIT:
+		visit(reinterpret_cast<ArrayInit*>(p_node)->nodes);
+		break;
+
+	case ScriptNode::ARRAY_INDEXING:
+	{
+		ArrayIndexing *indexing = reinterpret_cast<ArrayIndexing*>(p_node);
+		visit(indexing->array);
+		visit(indexing->index);
+		break;
+	}
+
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		visit(sum->left);
+		visit(sum->right);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		visit(pro->left);
+		visit(pro->right);
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	{
+		Comparison *comp = reinterpret_cast<Comparison*>(p_node);
+		visit(comp->left);
+		visit(comp->right);
+		break;
+	}
+
+	case ScriptNode::AND:
+	{
+		And *a = reinterpret_cast<And*>(p_node);
+		visit(a->left);
+		visit(a->right);
+		break;
+	}
+
+	case ScriptNode::OR:
+	{
+		Or *o = reinterpret_cast<Or*>(p_node);
+		visit(o->left);
+		visit(o->right);
+		break;
+	}
+
+	case ScriptNode::PARENTHESES:
+		visit(reinterpret_cast<Parentheses*>(p_node)->node);
+		break;
+
+	case ScriptNode::IF:
+	{
+		If *ifstat = reinterpret_cast<If*>(p_node);
+
+		for (int c = 0; c < ifstat->elements.size(); c++)
+		{
+			IfElement *e = ifstat->elements[c];
+
+			if (e->branch != IfElement::BRANCH_ELSE)
+				visit(e->passtest);
+
+			visit(e->node);
+		}
+		break;
+	}
+
+	case ScriptNode::BLOCK:
+		visit(reinterpret_cast<Block*>(p_node)->lines);
+		break;
+
+	case ScriptNode::FUNCTIONCALL:
+		visit(reinterpret_cast<FunctionCall*>(p_node)->params);
+		break;
+
+	case ScriptNode::STATICFUNC:
+		visit(reinterpret_cast<StaticFuncCall*>(p_node)->params);
+		break;
+
+	case ScriptNode::SUPERFUNC:
+		visit(reinterpret_cast<SuperFunction*>(p_node)->params);
+		break;
+
+	case ScriptNode::CONSTRUCTOR:
+		visit(reinterpret_cast<Constructor*>(p_node)->params);
+		break;
+
+	case ScriptNode::YIELD:
+		visit(reinterpret_cast<Yield*>(p_node)->params);
+		break;
+
+	case ScriptNode::RETURN:
+		visit(reinterpret_cast<Return*>(p_node)->val);
+		break;
+
+	case ScriptNode::FOR:
+	{
+		ForLoop *loop = reinterpret_cast<ForLoop*>(p_node);
+		visit(loop->decl);
+		visit(loop->passcheck);
+		visit(loop->func);
+		visit(loop->update);
+		break;
+	}
+
+	case ScriptNode::WHILE:
+	{
+		WhileLoop *loop = reinterpret_cast<WhileLoop*>(p_node);
+		visit(loop->passcheck);
+		visit(loop->func);
+		break;
+	}
+
+	case ScriptNode::COMPOSITION:
+		visit(reinterpret_cast<Composition*>(p_node)->nodes);
+		break;
+
+	case ScriptNode::PATH:
+	{
+		Path *path = reinterpret_cast<Path*>(p_node);
+		visit(path->origin->node);
+
+		for (int c = 0; c < path->path.size(); c++)
+			if (path->path[c]->type == ScriptNode::MEMBERFUNC)
+				visit(reinterpret_cast<MemberFunc*>(path->path[c])->args);
+		break;
+	}
+
+	case ScriptNode::ORIENTATION:
+		visit(reinterpret_cast<Orientation*>(p_node)->right);
+		break;
+
+	case ScriptNode::NOT:
+		visit(reinterpret_cast<Not*>(p_node)->right);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void Resolver::reference(VariableNode *p_var, bool p_write)
+{
+	switch (mode)
+	{
+	case COLLECT_SCOPES:
+		if (!scopes.contains(p_var->name))
+			scopes.set(p_var->name, scope);
+		else if (scopes[p_var->name] != scope)
+			scopes.set(p_var->name, SHARED_SCOPE);
+		break;
+
+	case COLLECT_LOCALS:
+		if (!first_write.contains(p_var->name))
+			first_write.set(p_var->name, p_write);
+		break;
+
+	case ASSIGN_SLOTS:
+		p_var->slot = slots.contains(p_var->name) ? slots[p_var->name] : -1;
+		break;
+	}
+}
+
+#undef GLOBAL_SCOPE
+#undef SHARED_SCOPE
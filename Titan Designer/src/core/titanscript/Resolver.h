@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/Data.h"
+#include "core/Dictionary.h"
+
+//Assigns a frame slot to the parameters and local variables of every function.
+//A variable is local when its first use inside a function is an assignment and
+//no other function or top level statement refers to it. Globals and everything
+//else keep the name based lookup in the State.
+class Resolver
+{
+public:
+	Resolver();
+
+	void resolve(const Line &p_root);
+
+private:
+	enum Mode
+	{
+		COLLECT_SCOPES,		//record which scopes refer to each name
+		COLLECT_LOCALS,		//record whether a name is first read or written in a function
+		ASSIGN_SLOTS		//write the slot indices into the VariableNodes
+	};
+
+	void resolve_function(Block *p_block, int p_scope);
+
+	void visit(ScriptNode *p_node);
+	void visit(const ScriptVector<ScriptNode> &p_nodes);
+	void visit_store(ScriptNode *p_target);
+
+	void reference(VariableNode *p_var, bool p_write);
+
+	Mode mode;
+	int scope;
+
+	//scope that refers to a name, SHARED_SCOPE when there are several
+	Dictionary<StringName, int> scopes;
+
+	//per function: true when the first use of a name is an assignment
+	Dictionary<StringName, bool> first_write;
+	Dictionary<StringName, int> slots;
+};
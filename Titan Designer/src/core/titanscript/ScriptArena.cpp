@@ -0,0 +1,126 @@
+#include "ScriptArena.h"
+
+#include <new>
+
+thread_local ScriptArena *ScriptArena::current = NULL;
+
+ScriptArena::ScriptArena()
+{
+	position = NULL;
+	remaining = 0;
+	size = 0;
+}
+
+ScriptArena::~ScriptArena()
+{
+	release();
+
+	if (current == this)
+		current = NULL;
+}
+
+void* ScriptArena::allocate(size_t p_size, Destructor p_destructor)
+{
+	char *block = static_cast<char*>(allocate_buffer(HEADER_SIZE + p_size));
+	void *ptr = block + HEADER_SIZE;
+
+	Header *header = reinterpret_cast<Header*>(block);
+	header->arena = this;
+	header->allocation = -1;
+
+	if (p_destructor)
+	{
+		header->allocation = allocations.size();
+		allocations.push_back({ ptr, p_destructor });
+	}
+
+	return ptr;
+}
+
+void ScriptArena::release()
+{
+	for (int c = allocations.size() - 1; c >= 0; c--)
+		if (allocations[c].destructor)
+			allocations[c].destructor(allocations[c].ptr);
+
+	for (int c = 0; c < chunks.size(); c++)
+		::operator delete(chunks[c].data);
+
+	allocations.clear();
+	chunks.clear();
+
+	position = NULL;
+	remaining = 0;
+	size = 0;
+}
+
+size_t ScriptArena::get_size() const
+{
+	return size;
+}
+
+void* ScriptArena::allocate_current(size_t p_size, Destructor p_destructor)
+{
+	if (current)
+		return current->allocate(p_size, p_destructor);
+
+	char *block = static_cast<char*>(::operator new(HEADER_SIZE + p_size));
+	reinterpret_cast<Header*>(block)->arena = NULL;
+
+	return block + HEADER_SIZE;
+}
+
+void ScriptArena::free(void *p_ptr)
+{
+	if (!p_ptr)
+		return;
+
+	Header *header = reinterpret_cast<Header*>(static_cast<char*>(p_ptr) - HEADER_SIZE);
+
+	//the memory of arena objects is only returned on release
+	if (header->arena)
+	{
+		if (header->allocation != -1)
+			header->arena->allocations[header->allocation].destructor = NULL;
+	}
+	else
+		::operator delete(header);
+}
+
+ScriptArena* ScriptArena::get_current()
+{
+	return current;
+}
+
+void* ScriptArena::allocate_buffer(size_t p_size)
+{
+	size_t aligned = (p_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	char *block;
+
+	//large blocks get a chunk of their own, the current chunk stays in use
+	if (aligned > CHUNK_SIZE / 4)
+		block = add_chunk(aligned);
+	else
+	{
+		if (aligned > remaining)
+		{
+			position = add_chunk(CHUNK_SIZE);
+			remaining = CHUNK_SIZE;
+		}
+
+		block = position;
+		position += aligned;
+		remaining -= aligned;
+	}
+
+	size += aligned;
+	return block;
+}
+
+char* ScriptArena::add_chunk(size_t p_size)
+{
+	char *data = static_cast<char*>(::operator new(p_size));
+	chunks.push_back({ data, p_size });
+
+	return data;
+}
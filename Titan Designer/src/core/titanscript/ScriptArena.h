@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "core/Array.h"
+#include "core/Vector.h"
+
+//Bump allocator that owns the ScriptNodes, Lines and tokens of one TitanScript.
+//Objects are placed in the order they are created, so the nodes of a function
+//end up next to each other. The buffers of their arrays come from the arena as
+//well, so releasing frees the chunks in one go and only runs the destructors of
+//the few objects that hold something outside the arena. Every object is preceded
+//by a small header that names its arena, so deleting one does not search the arenas.
+class ScriptArena
+{
+public:
+	typedef void(*Destructor)(void*);
+
+	ScriptArena();
+	~ScriptArena();
+
+	//p_destructor is run on release, NULL for objects that own nothing outside the arena
+	void* allocate(size_t p_size, Destructor p_destructor);
+
+	//memory without a header or destructor, for array buffers and token texts
+	void* allocate_buffer(size_t p_size);
+
+	//runs the registered destructors and frees all chunks
+	void release();
+
+	//bytes handed out since the last release
+	size_t get_size() const;
+
+	//used by the operator new and delete of ScriptNode and Line,
+	//objects go to the heap when no arena is current
+	static void* allocate_current(size_t p_size, Destructor p_destructor);
+	static void free(void *p_ptr);
+
+	static ScriptArena* get_current();
+
+	//makes an arena current while lexing or parsing, per thread
+	class Scope
+	{
+	public:
+		Scope(ScriptArena *p_arena) { previous = current; current = p_arena; }
+		~Scope() { current = previous; }
+
+	private:
+		ScriptArena *previous;
+	};
+
+private:
+	struct Chunk
+	{
+		char *data;
+		size_t size;
+	};
+
+	struct Allocation
+	{
+		void *ptr;
+		Destructor destructor;
+	};
+
+	//in front of every object, arena is NULL for the ones on the heap
+	//and allocation is -1 for the ones without a destructor
+	struct Header
+	{
+		ScriptArena *arena;
+		int allocation;
+	};
+
+	static const size_t CHUNK_SIZE = 32 * 1024;
+	static const size_t ALIGNMENT = alignof(std::max_align_t);
+	static const size_t HEADER_SIZE = (sizeof(Header) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	char* add_chunk(size_t p_size);
+
+	Array<Chunk> chunks;
+	Array<Allocation> allocations;
+
+	char *position;
+	size_t remaining;
+	size_t size;
+
+	static thread_local ScriptArena *current;
+};
+
+//Allocator for the arrays of nodes and lines. It takes the arena that is current when the
+//array is made and never hands memory back to it, arrays made outside an arena use the heap.
+//A copy or move takes the arena of the source along, so an array assigned from a newer
+//parse keeps working when the arena it was made in is released.
+template<class T>
+class ScriptAllocator
+{
+public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	template<class U>
+	struct rebind { typedef ScriptAllocator<U> other; };
+
+	ScriptAllocator() : arena(ScriptArena::get_current()) { }
+
+	template<class U>
+	ScriptAllocator(const ScriptAllocator<U> &p_allocator) : arena(p_allocator.arena) { }
+
+	T* allocate(size_t p_count)
+	{
+		if (arena)
+			return static_cast<T*>(arena->allocate_buffer(p_count * sizeof(T)));
+
+		return static_cast<T*>(::operator new(p_count * sizeof(T)));
+	}
+	void deallocate(T *p_ptr, size_t p_count)
+	{
+		if (!arena)
+			::operator delete(p_ptr);
+	}
+
+	template<class U>
+	bool operator==(const ScriptAllocator<U> &p_allocator) const { return arena == p_allocator.arena; }
+	template<class U>
+	bool operator!=(const ScriptAllocator<U> &p_allocator) const { return arena != p_allocator.arena; }
+
+	ScriptArena *arena;
+};
+
+//pointer array of a node or line that lives in the arena
+template<class T>
+using ScriptVector = Vector<T, ScriptAllocator<T*>>;
@@ -1,8 +1,69 @@
 #include "ScriptNode.h"
 
 #include "core/NodeManager.h"
+#include "ScriptArena.h"
+#include "CommandBuffer.h"
+#include "types/MethodMaster.h"
+
+static void destroy_constant(void *p_node)
+{
+	static_cast<Constant*>(p_node)->~Constant();
+}
 
 ScriptNode::ScriptNode()
 {
-	NodeManager::AddNode(this);
+	if (!ScriptArena::get_current())					//The arena owns the node otherwise
+		NodeManager::AddNode(this);
+}
+
+void* ScriptNode::operator new(size_t p_size)
+{
+	return ScriptArena::allocate_current(p_size, NULL);
+}
+
+void ScriptNode::operator delete(void *p_ptr)
+{
+	ScriptArena::free(p_ptr);
+}
+
+void* Constant::operator new(size_t p_size)
+{
+	return ScriptArena::allocate_current(p_size, destroy_constant);
+}
+
+//=========================================================================
+//Inline cached lookups
+//=========================================================================
+
+Method* MemberFunc::get_method(const Variant &p_receiver)
+{
+	void *type_ptr = p_receiver.get_type_ptr();
+	Method *m = cache.lookup(type_ptr);
+
+	if (!m && (m = MMASTER->get_method(p_receiver.get_type(), method_name)))
+		cache.insert(type_ptr, m, CommandBuffer::current != NULL);
+
+	return m;
+}
+
+Property* MemberVar::get_property(const Variant &p_receiver)
+{
+	void *type_ptr = p_receiver.get_type_ptr();
+	Property *p = cache.lookup(type_ptr);
+
+	if (!p && (p = MMASTER->get_property(p_receiver.get_type(), variable_name)))
+		cache.insert(type_ptr, p, CommandBuffer::current != NULL);
+
+	return p;
+}
+
+Method* SuperFunction::get_method(const Variant &p_extension)
+{
+	void *type_ptr = p_extension.get_type_ptr();
+	Method *m = cache.lookup(type_ptr);
+
+	if (!m && (m = MMASTER->get_method(p_extension.get_type(), name)))
+		cache.insert(type_ptr, m, CommandBuffer::current != NULL);
+
+	return m;
 }
\ No newline at end of file
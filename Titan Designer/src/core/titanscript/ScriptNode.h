@@ -1,17 +1,81 @@
 #pragma once
 
+#include <atomic>
+
 #include "core/variant/Variant.h"
 #include "types/Method.h"
 #include "core/Property.h"
+#include "ScriptArena.h"
 
 struct Init;
 
+//Polymorphic inline cache for member lookups, keyed on the receiver's type pointer.
+//The MethodMaster tables are complete after start-up, so entries never go stale.
+//Workers of a parallel update run the same nodes, they only fill free entries: an
+//entry is written before count is raised, so a reader never sees a half written one
+template<class T>
+struct InlineCache
+{
+	static const int SIZE = 4;
+
+	T* lookup(void *p_type) const
+	{
+		int size = count.load(std::memory_order_acquire);
+
+		for (int c = 0; c < size; c++)
+			if (types[c] == p_type)
+				return entries[c];
+
+		return NULL;
+	}
+	void insert(void *p_type, T *p_entry, bool p_concurrent)
+	{
+		if (p_concurrent)
+		{
+			while (writing.test_and_set(std::memory_order_acquire));
+
+			int size = count.load(std::memory_order_relaxed);
+
+			if (size < SIZE && !lookup(p_type))
+			{
+				types[size] = p_type;
+				entries[size] = p_entry;
+				count.store(size + 1, std::memory_order_release);
+			}
+
+			writing.clear(std::memory_order_release);
+			return;
+		}
+
+		int size = count.load(std::memory_order_relaxed);
+		int index = size < SIZE ? size : next;
+		next = (index + 1) % SIZE;
+
+		types[index] = p_type;
+		entries[index] = p_entry;
+
+		if (size < SIZE)
+			count.store(size + 1, std::memory_order_release);
+	}
+
+	void *types[SIZE];
+	T *entries[SIZE];
+	std::atomic<int> count{ 0 };
+	int next = 0;
+	std::atomic_flag writing = ATOMIC_FLAG_INIT;
+};
+
 struct ScriptNode
 {
 public:
 	ScriptNode();
 	virtual ~ScriptNode() {}
 
+	//nodes are placed in the ScriptArena of the script being parsed, their arrays use it too,
+	//so the arena does not destroy them on release
+	static void* operator new(size_t p_size);
+	static void operator delete(void *p_ptr);
+
 	virtual void clean() { }
 
 	enum Type 
@@ -27,12 +91,18 @@ public:
 		PATHORIGIN, ORIENTATION, NOT,
 		STATICFUNC, STATICVAR, SUPERVAR, 
 		SUPERFUNC, MEMBERFUNC, MEMBERVAR,
-		CONSTRUCTOR, TYPE_SPECIFIER
+		CONSTRUCTOR, TYPE_SPECIFIER, YIELD
 	};
 
 	Type type = UNDEF;
 
 	bool isconst = false;
+
+	//source line of a statement, 0 for expressions
+	int line = 0;
+
+	//Variant::Type the expression is proven to produce, UNDEF when unknown. Set by the TypeInference
+	int result_type = Variant::UNDEF;
 		
 	int GetType() { return type; }
 };
@@ -41,6 +111,9 @@ struct Constant : ScriptNode
 {
 	Constant() { type = CONSTANT; }
 	Constant(const Variant &p_value) : Constant() { value = p_value; }
+
+	//the value can hold a box on the heap, the only node the arena destroys
+	static void* operator new(size_t p_size);
 	
 	Variant value;
 };
@@ -64,21 +137,21 @@ struct ArrayInit : ScriptNode
 	ArrayInit() { type = ARRAY_INIT; }
 	ArrayInit(const Vector<ScriptNode> &p_nodes) { nodes = p_nodes; type = ARRAY_INIT; }
 
-	Vector<ScriptNode> nodes;
+	ScriptVector<ScriptNode> nodes;
 };
 struct Sum : ScriptNode
 {
 	Sum() { type = SUM; }
-	Sum(ScriptNode *l, ScriptNode *r, const StringName &s) : Sum() { op = s; left = l; right = r; }
+	Sum(ScriptNode *l, ScriptNode *r, Variant::OperatorType o) : Sum() { op = o; left = l; right = r; }
 	ScriptNode *left, *right;
-	StringName op;
+	Variant::OperatorType op;	//ADD or SUBTRACT
 };
 struct Product : ScriptNode
 {
 	Product() { type = PRODUCT; }
-	Product(ScriptNode *l, ScriptNode *r, const StringName &s) { op = s; left = l; right = r; type = PRODUCT; }
+	Product(ScriptNode *l, ScriptNode *r, Variant::OperatorType o) { op = o; left = l; right = r; type = PRODUCT; }
 	ScriptNode *left, *right;
-	StringName op;
+	Variant::OperatorType op;	//MULTIPLY or DIVIDE
 };
 struct Parentheses : ScriptNode
 {
@@ -100,8 +173,11 @@ struct Block : ScriptNode
 	Block(Vector<ScriptNode> ls) { lines = ls; type = BLOCK; }
 	Block(Vector<ScriptNode> ls, Vector<ScriptNode> ps) { params = ps; lines = ls; type = BLOCK; }
 
-	Vector<ScriptNode> params, lines;
+	ScriptVector<ScriptNode> params, lines;
 	bool isfunction = false;
+
+	//frame slots needed by the parameters and locals of a function, set by the Resolver
+	int slot_count = 0;
 };
 struct FunctionInit : ScriptNode
 {
@@ -117,21 +193,29 @@ struct FunctionCall : ScriptNode
 	FunctionCall(const StringName &n, Vector<ScriptNode> ps) { params = ps; name = n; type = FUNCTIONCALL; }
 	
 	StringName name;
-	Vector<ScriptNode> params;
+	ScriptVector<ScriptNode> params;
 };
 struct IfElement : ScriptNode
 {
 	IfElement() { type = IFELEMENT; }
 	IfElement(ScriptNode *p, Block *b) { node = b; passtest = p; type = IFELEMENT; }
-	ScriptNode *passtest;
+
+	enum Branch
+	{
+		BRANCH_IF,
+		BRANCH_ELSEIF,
+		BRANCH_ELSE
+	};
+
+	ScriptNode *passtest = NULL;
 	Block *node;
-	StringName name;
+	Branch branch = BRANCH_IF;
 };
 struct If : ScriptNode
 {
 	If() { type = IF; }
 	If(Vector<IfElement> e) { elements = e; type = IF; }
-	Vector<IfElement> elements;
+	ScriptVector<IfElement> elements;
 };
 struct And : ScriptNode
 {
@@ -171,31 +255,31 @@ struct Composition : ScriptNode
 	Composition() { type = COMPOSITION; }
 	Composition(Vector<ScriptNode> n) { nodes = n; type = COMPOSITION; }
 
-	Vector<ScriptNode> nodes;
+	ScriptVector<ScriptNode> nodes;
 };
 struct Comparison : ScriptNode
 {
 	Comparison() { type = COMPARISON; }
-	Comparison(const StringName &n, ScriptNode *l, ScriptNode *r) { name = n; left = l; right = r; type = COMPARISON; }
+	Comparison(Variant::EvaluationType e, ScriptNode *l, ScriptNode *r) { eval = e; left = l; right = r; type = COMPARISON; }
 
 	ScriptNode *left, *right;
-	StringName name;
+	Variant::EvaluationType eval;
 };
 struct ChangeOne : ScriptNode
 {
 	ChangeOne() { type = CHANGEONE; }
-	ChangeOne(ScriptNode *v, const StringName &o) { var = v; op = o; type = CHANGEONE; }
+	ChangeOne(ScriptNode *v, Variant::OperatorType o) { var = v; op = o; type = CHANGEONE; }
 
 	ScriptNode *var;
-	StringName op;
+	Variant::OperatorType op;	//ADD for ++, SUBTRACT for --
 };
 struct Modify : ScriptNode
 {
 	Modify() { type = MODIFY; }
-	Modify(ScriptNode *vl, ScriptNode *vr, const StringName &o) { val = vl; var = vr; op = o; type = MODIFY; }
+	Modify(ScriptNode *vl, ScriptNode *vr, Variant::OperatorType o) { val = vl; var = vr; op = o; type = MODIFY; }
 
 	ScriptNode *val, *var;
-	StringName op;
+	Variant::OperatorType op;
 };
 struct PathOrigin : ScriptNode
 {
@@ -208,21 +292,30 @@ struct Path : ScriptNode
 	Path(Vector<ScriptNode> p, const StringName &n) { path = p; type = PATH; }
 
 	PathOrigin *origin;
-	Vector<ScriptNode> path;
+	ScriptVector<ScriptNode> path;
 };
 struct MemberFunc : ScriptNode
 {
 	MemberFunc() { type = MEMBERFUNC; }
+
+	Method* get_method(const Variant &p_receiver);
+
 	Method *bounded_method = NULL;
 	StringName method_name;
-	Vector<ScriptNode> args;
+	ScriptVector<ScriptNode> args;
+
+	InlineCache<Method> cache;
 };
 struct MemberVar : ScriptNode
 {
 	MemberVar() { type = MEMBERVAR; }
 
+	Property* get_property(const Variant &p_receiver);
+
 	StringName variable_name;
 	Property *getset;
+
+	InlineCache<Property> cache;
 };
 struct VariableNode : ScriptNode
 {
@@ -230,6 +323,9 @@ struct VariableNode : ScriptNode
 	VariableNode(const StringName &n) { name = n; type = VARIABLE; }
 
 	StringName name;
+
+	//index in the frame of the enclosing function, -1 for globals
+	int slot = -1;
 };
 struct Orientation : ScriptNode
 {
@@ -237,7 +333,7 @@ struct Orientation : ScriptNode
 	Orientation(ScriptNode *r) { right = r; type = ORIENTATION; }
 
 	ScriptNode *right;
-	char o;
+	bool negate = false;
 };
 struct Not : ScriptNode
 {
@@ -252,7 +348,7 @@ struct StaticFuncCall : ScriptNode
 	StaticFuncCall(const StringName &n, Vector<ScriptNode> ps) { params = ps; name = n; type = STATICFUNC; }
 
 	StringName name;
-	Vector<ScriptNode> params;
+	ScriptVector<ScriptNode> params;
 };
 struct StaticVariable : ScriptNode
 {
@@ -272,8 +368,12 @@ struct SuperFunction : ScriptNode
 	SuperFunction() { type = SUPERFUNC; }
 	SuperFunction(const StringName &n, Vector<ScriptNode> ps) { params = ps; name = n; type = SUPERFUNC; }
 
+	Method* get_method(const Variant &p_extension);
+
 	StringName name;
-	Vector<ScriptNode> params;
+	ScriptVector<ScriptNode> params;
+
+	InlineCache<Method> cache;
 };
 struct Constructor : ScriptNode
 {
@@ -281,7 +381,7 @@ struct Constructor : ScriptNode
 	Constructor(const StringName &n, Vector<ScriptNode> ps) { params = ps; name = n; type = CONSTRUCTOR; }
 
 	StringName name;
-	Vector<ScriptNode> params;
+	ScriptVector<ScriptNode> params;
 };
 struct TypeSpecifier : ScriptNode
 {
@@ -289,4 +389,20 @@ struct TypeSpecifier : ScriptNode
 	TypeSpecifier(const VariantType &p_referenced_type) { referenced_type = p_referenced_type; type = TYPE_SPECIFIER; }
 
 	VariantType referenced_type;
+};
+//suspends the running function, see ScriptScheduler
+struct Yield : ScriptNode
+{
+	enum WaitType
+	{
+		WAIT_FRAME,		//yield
+		WAIT_SECONDS,	//wait(seconds)
+		WAIT_SIGNAL		//wait_signal(object, "name")
+	};
+
+	Yield() { type = YIELD; }
+	Yield(WaitType w, Vector<ScriptNode> ps) { wait = w; params = ps; type = YIELD; }
+
+	WaitType wait = WAIT_FRAME;
+	ScriptVector<ScriptNode> params;
 };
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "core/Data.h"
+#include "resources/File.h"
+#include "Bytecode.h"
+
+ScriptProfiler *ScriptProfiler::singleton;
+
+std::atomic<bool> ScriptProfiler::active;
+std::atomic<int> ScriptProfiler::ticks;
+thread_local int ScriptProfiler::sampled_ticks;
+
+thread_local Array<ScriptProfiler::Frame> ScriptProfiler::frames;
+
+ScriptProfiler::ScriptProfiler()
+{
+	sampler = NULL;
+	interval = 1000;
+	total_ticks = 0;
+}
+
+void ScriptProfiler::Init()
+{
+	singleton = new ScriptProfiler;
+}
+
+ScriptProfiler* ScriptProfiler::get_singleton()
+{
+	return singleton;
+}
+
+void ScriptProfiler::start(int p_interval)
+{
+	if (sampler)
+		return;
+
+	interval = p_interval;
+	active = true;
+
+	sampler = new std::thread(&ScriptProfiler::run_sampler, this);
+}
+
+void ScriptProfiler::stop()
+{
+	if (!sampler)
+		return;
+
+	active = false;
+
+	sampler->join();
+	delete sampler;
+	sampler = NULL;
+}
+
+void ScriptProfiler::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	functions.clear();
+	lines.clear();
+	stacks.clear();
+	total_ticks = 0;
+}
+
+bool ScriptProfiler::is_running() const
+{
+	return sampler != NULL;
+}
+
+void ScriptProfiler::run_sampler()
+{
+	while (active)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(interval));
+		ticks++;
+	}
+}
+
+//=========================================================================
+//Call stack
+//=========================================================================
+
+void ScriptProfiler::enter(const State *p_state, const Function *p_function, const CompiledFunction *p_compiled, const int *p_pc)
+{
+	//ticks that passed outside of script code are not ours to count
+	if (frames.size() == 0)
+		sampled_ticks = ticks;
+
+	Frame frame;
+	frame.state = p_state;
+	frame.function = p_function;
+	frame.compiled = p_compiled;
+	frame.pc = p_pc;
+	frame.line = 0;
+
+	frames.push_back(frame);
+}
+
+void ScriptProfiler::leave()
+{
+	if (frames.size() > 0)
+		frames.removelast();
+}
+
+void ScriptProfiler::set_line(int p_line)
+{
+	if (frames.size() > 0 && p_line)
+		frames.getlast().line = p_line;
+}
+
+void ScriptProfiler::sample()
+{
+	int now = ticks;
+	int count = now - sampled_ticks;
+	sampled_ticks = now;
+
+	if (count == 0 || frames.size() == 0)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Array<String> names;
+	String stack;
+
+	for (int c = 0; c < frames.size(); c++)
+	{
+		String name = get_name(frames[c]);
+		String line = name + ":" + String(get_line(frames[c]));
+		bool top = c == frames.size() - 1;
+
+		//recursion counts once towards the inclusive time
+		add(functions, name, count, !names.contains(name), top);
+		add(lines, line, count, !names.contains(line), top);
+
+		names.push_back(name);
+		names.push_back(line);
+
+		stack += (c > 0 ? ";" : "") + name;
+	}
+
+	stacks[stack] += count;
+	total_ticks += count;
+}
+
+String ScriptProfiler::get_name(const Frame &p_frame)
+{
+	String function = p_frame.compiled ? p_frame.compiled->name.get_source() : p_frame.function->name;
+
+	return p_frame.state->name + ":" + function;
+}
+
+int ScriptProfiler::get_line(const Frame &p_frame)
+{
+	if (!p_frame.compiled)
+		return p_frame.line;
+
+	//the pc has moved past the instruction that is running
+	int pc = std::max(*p_frame.pc - 1, 0);
+
+	return pc < p_frame.compiled->lines.size() ? p_frame.compiled->lines[pc] : 0;
+}
+
+void ScriptProfiler::add(Dictionary<String, Cost> &r_costs, const String &p_name, int p_ticks, bool p_inclusive, bool p_exclusive)
+{
+	Cost &cost = r_costs[p_name];
+	cost.name = p_name;
+
+	if (p_inclusive)
+		cost.inclusive += p_ticks;
+
+	if (p_exclusive)
+		cost.exclusive += p_ticks;
+}
+
+//=========================================================================
+//Output
+//=========================================================================
+
+Array<ScriptProfiler::Cost> ScriptProfiler::get_sorted(Dictionary<String, Cost> &p_costs)
+{
+	Array<Cost> sorted;
+
+	for (std::pair<const String, Cost> &cost : p_costs)
+		sorted.push_back(cost.second);
+
+	std::sort(sorted.begin(), sorted.end(), [](const Cost &l, const Cost &r)
+	{
+		return l.exclusive != r.exclusive ? l.exclusive > r.exclusive : l.inclusive > r.inclusive;
+	});
+
+	return sorted;
+}
+
+Array<String> ScriptProfiler::get_report(int p_count)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Array<String> report;
+	float ms = interval / 1000.0f;
+
+	report.push_back("Script profile: " + String(total_ticks) + " samples, " + String(total_ticks * ms) + " ms");
+
+	Array<Cost> sorted = get_sorted(functions);
+	report.push_back("Functions (exclusive ms, inclusive ms):");
+
+	for (int c = 0; c < sorted.size() && c < p_count; c++)
+		report.push_back("\t" + String(sorted[c].exclusive * ms) + "\t" + String(sorted[c].inclusive * ms) + "\t" + sorted[c].name);
+
+	sorted = get_sorted(lines);
+	report.push_back("Lines (exclusive ms, inclusive ms):");
+
+	for (int c = 0; c < sorted.size() && c < p_count; c++)
+		report.push_back("\t" + String(sorted[c].exclusive * ms) + "\t" + String(sorted[c].inclusive * ms) + "\t" + sorted[c].name);
+
+	return report;
+}
+
+void ScriptProfiler::dump_folded(const File &p_file)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::ofstream file(p_file.get_absolute_path());
+
+	if (!file.is_open())
+	{
+		T_ERROR("Could not write profile: " + p_file.get_absolute_path());
+		return;
+	}
+
+	for (std::pair<const String, int> &stack : stacks)
+		file << stack.first.c_str() << " " << stack.second << "\n";
+
+	file.close();
+}
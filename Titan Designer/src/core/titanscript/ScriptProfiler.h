@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "core/Array.h"
+#include "core/Dictionary.h"
+#include "core/String.h"
+
+#define PROFILER ScriptProfiler::get_singleton()
+
+class State;
+class Function;
+class File;
+struct CompiledFunction;
+
+//Sampling profiler for TitanScript. A sampler thread counts ticks, the interpreter
+//that is running script code takes the sample the next time it checks, so call
+//stacks are only read by the thread that owns them. Each sample is weighted by the
+//ticks it covers, a long native call inside a script is not undercounted.
+class ScriptProfiler
+{
+public:
+	ScriptProfiler();
+
+	static void Init();
+	static ScriptProfiler* get_singleton();
+
+	void start(int p_interval = 1000);		//microseconds between ticks
+	void stop();
+	void clear();
+
+	bool is_running() const;
+
+	//called by the Executer and the VirtualMachine while active is set
+	void enter(const State *p_state, const Function *p_function, const CompiledFunction *p_compiled, const int *p_pc);
+	void leave();
+	void set_line(int p_line);
+	void sample();
+
+	//a readable table of the functions and lines with the most exclusive time
+	Array<String> get_report(int p_count = 10);
+
+	//one line per call stack with its sample count, the input of flamegraph.pl
+	void dump_folded(const File &p_file);
+
+	//checked by the interpreters, cheap enough to test for every instruction
+	static std::atomic<bool> active;
+	static bool has_pending_ticks() { return ticks.load(std::memory_order_relaxed) != sampled_ticks; }
+
+private:
+	//counted by the sampler, each thread samples the ticks since the last ones it took, so
+	//workers of a parallel update do not take or reset the ticks of each other
+	static std::atomic<int> ticks;
+	static thread_local int sampled_ticks;
+
+	struct Frame
+	{
+		const State *state;
+		const Function *function;
+		const CompiledFunction *compiled;
+		const int *pc;			//the bytecode frames read their line from the pc
+		int line;
+	};
+
+	struct Cost
+	{
+		String name;
+		int inclusive = 0;
+		int exclusive = 0;
+	};
+
+	static String get_name(const Frame &p_frame);
+	static int get_line(const Frame &p_frame);
+	static void add(Dictionary<String, Cost> &r_costs, const String &p_name, int p_ticks, bool p_inclusive, bool p_exclusive);
+	static Array<Cost> get_sorted(Dictionary<String, Cost> &p_costs);
+
+	void run_sampler();
+
+	std::thread *sampler;
+	int interval;
+
+	std::mutex mutex;
+	Dictionary<String, Cost> functions;
+	Dictionary<String, Cost> lines;
+	Dictionary<String, int> stacks;
+	int total_ticks;
+
+	static thread_local Array<Frame> frames;
+	static ScriptProfiler *singleton;
+};
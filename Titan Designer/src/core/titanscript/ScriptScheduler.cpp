@@ -0,0 +1,219 @@
+#include "ScriptScheduler.h"
+
+#include "core/Time.h"
+#include "types/Scriptable.h"
+#include "VirtualMachine.h"
+#include "CommandBuffer.h"
+
+ScriptScheduler *ScriptScheduler::singleton;
+
+//=========================================================================
+//SignalWaiter
+//=========================================================================
+
+//connected as a lambda, wakes the coroutine on the first emission only
+struct SignalWaiter : Method
+{
+	SignalWaiter(Coroutine *p_coroutine)
+	{
+		coroutine = p_coroutine;
+		thunk = fire;
+		arg_count = 0;
+	}
+
+	static void fire(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		SignalWaiter *waiter = static_cast<SignalWaiter*>(p_method);
+
+		if (!waiter->coroutine)
+			return;
+
+		SCHEDULER->wake(waiter->coroutine, p_args ? p_args[0] : NULL_VAR);
+		waiter->coroutine = NULL;
+	}
+
+	Coroutine *coroutine;
+};
+
+//=========================================================================
+//ScriptScheduler
+//=========================================================================
+
+ScriptScheduler::ScriptScheduler()
+{
+}
+
+void ScriptScheduler::Init()
+{
+	singleton = new ScriptScheduler;
+}
+
+ScriptScheduler* ScriptScheduler::get_singleton()
+{
+	return singleton;
+}
+
+void ScriptScheduler::park(Coroutine *p_coroutine, Yield::WaitType p_wait, const Variant *p_args)
+{
+	if (CommandBuffer::current)						//Yielded in a parallel update
+	{
+		CommandBuffer::current->park(p_coroutine, p_wait, p_args);
+		return;
+	}
+
+	switch (p_wait)
+	{
+	case Yield::WAIT_SECONDS:
+	{
+		float seconds = p_args[0];
+
+		p_coroutine->wake_time = TIME->absolute_time + static_cast<long>(seconds * 1000000.0f);
+		park_sleeping(p_coroutine);
+		return;
+	}
+
+	case Yield::WAIT_SIGNAL:
+	{
+		Scriptable *source = p_args[0].isdef() ? dynamic_cast<Scriptable*>(p_args[0].operator Object*()) : NULL;
+		StringName name = p_args[1].ToString();
+
+		if (!source || !MMASTER->signal_exists(source->get_type(), name))
+		{
+			T_ERROR("wait_signal needs an object and the name of one of its signals");
+			break;										//Continue next frame instead
+		}
+
+		p_coroutine->source = source;
+		p_coroutine->signal_name = name;
+		p_coroutine->waiter = new SignalWaiter(p_coroutine);
+
+		source->connect(name, Connection::create_from_lambda(p_coroutine->waiter));
+		listening.push_back(p_coroutine);
+		return;
+	}
+
+	default:
+		break;
+	}
+
+	next_frame.push_back(p_coroutine);
+}
+
+void ScriptScheduler::park_sleeping(Coroutine *p_coroutine)
+{
+	int index = sleeping.size();
+
+	while (index > 0 && sleeping[index - 1]->wake_time <= p_coroutine->wake_time)
+		index--;
+
+	sleeping.insert(index, p_coroutine);
+}
+
+void ScriptScheduler::wake(Coroutine *p_coroutine, const Variant &p_value)
+{
+	for (int c = 0; c < listening.size(); c++)
+	{
+		if (listening[c] == p_coroutine)
+		{
+			listening.clear(c);
+			p_coroutine->value = p_value;
+			signaled.push_back(p_coroutine);
+			return;
+		}
+	}
+}
+
+void ScriptScheduler::update()
+{
+	long now = TIME->absolute_time;
+
+	//coroutines that yield while resuming are parked for the next update
+	resuming = next_frame;
+	next_frame.clear();
+
+	resuming.push_back(signaled);
+	signaled.clear();
+
+	while (sleeping.size() > 0 && sleeping.getlast()->wake_time <= now)
+	{
+		resuming.push_back(sleeping.getlast());
+		sleeping.removelast();
+	}
+
+	for (int c = 0; c < resuming.size(); c++)
+	{
+		Coroutine *coroutine = resuming[c];
+
+		if (!coroutine)											//Cancelled by an earlier one
+			continue;
+
+		resuming.set(c, NULL);
+		disconnect(coroutine);
+
+		coroutine->vm->resume(coroutine);
+		delete coroutine;
+	}
+
+	resuming.clear();
+}
+
+void ScriptScheduler::cancel(VirtualMachine *p_vm)
+{
+	remove(p_vm, NULL);
+}
+
+void ScriptScheduler::cancel(Object *p_object)
+{
+	remove(NULL, p_object);
+}
+
+void ScriptScheduler::remove(VirtualMachine *p_vm, Object *p_object)
+{
+	remove(p_vm, p_object, next_frame);
+	remove(p_vm, p_object, sleeping);
+	remove(p_vm, p_object, listening);
+	remove(p_vm, p_object, signaled);
+
+	for (int c = 0; c < resuming.size(); c++)
+	{
+		if (resuming[c] && matches(resuming[c], p_vm, p_object))
+		{
+			disconnect(resuming[c]);
+			delete resuming[c];
+			resuming.set(c, NULL);
+		}
+	}
+}
+
+void ScriptScheduler::remove(VirtualMachine *p_vm, Object *p_object, Array<Coroutine*> &r_coroutines)
+{
+	for (int c = r_coroutines.size() - 1; c >= 0; c--)
+	{
+		if (!matches(r_coroutines[c], p_vm, p_object))
+			continue;
+
+		disconnect(r_coroutines[c]);
+		delete r_coroutines[c];
+		r_coroutines.clear(c);
+	}
+}
+
+bool ScriptScheduler::matches(Coroutine *p_coroutine, VirtualMachine *p_vm, Object *p_object)
+{
+	if (p_object)
+		return p_coroutine->owner == p_object || p_coroutine->source == p_object;
+
+	return p_coroutine->vm == p_vm;
+}
+
+void ScriptScheduler::disconnect(Coroutine *p_coroutine)
+{
+	if (!p_coroutine->waiter)
+		return;
+
+	if (p_coroutine->source->signals.contains(p_coroutine->signal_name))
+		p_coroutine->source->signals[p_coroutine->signal_name].detach_connection(p_coroutine->waiter);
+
+	delete p_coroutine->waiter;
+	p_coroutine->waiter = NULL;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/Array.h"
+#include "Bytecode.h"
+
+#define SCHEDULER ScriptScheduler::get_singleton()
+
+class VirtualMachine;
+class Scriptable;
+class Object;
+
+//A compiled function suspended at a yield. The registers of its frame are
+//copied out of the VM stack, so any number of them can be parked at once.
+struct Coroutine
+{
+	VirtualMachine *vm;
+	CompiledFunction *function;
+
+	//the object the script extends
+	Variant self;
+	Object *owner = NULL;
+
+	Array<Variant> registers;
+	int pc;
+	int result_register;
+
+	//written into the result register on resume
+	Variant value;
+
+	//wait, in microseconds like Time::absolute_time
+	long wake_time = 0;
+
+	//wait_signal
+	Scriptable *source = NULL;
+	StringName signal_name;
+	Method *waiter = NULL;
+};
+
+//Parks the coroutines of all scripts and resumes them from Time::OnUpdate.
+//Each tick only touches the coroutines that are due: the ones that yielded
+//last frame, the ones whose signal fired and the sleepers whose time has come.
+class ScriptScheduler
+{
+public:
+	ScriptScheduler();
+
+	static void Init();
+	static ScriptScheduler* get_singleton();
+
+	//takes ownership of p_coroutine until it has been resumed
+	void park(Coroutine *p_coroutine, Yield::WaitType p_wait, const Variant *p_args);
+
+	//called by the connection of a coroutine that waits on a signal
+	void wake(Coroutine *p_coroutine, const Variant &p_value);
+
+	void update();
+
+	//drop the coroutines of a VirtualMachine whose functions get recompiled or freed
+	void cancel(VirtualMachine *p_vm);
+
+	//drop the coroutines run by an object or waiting on one of its signals, called when it is deleted
+	void cancel(Object *p_object);
+
+private:
+	void park_sleeping(Coroutine *p_coroutine);
+	void disconnect(Coroutine *p_coroutine);
+
+	//removes the coroutines of p_vm, or of p_object when that is set
+	void remove(VirtualMachine *p_vm, Object *p_object);
+	void remove(VirtualMachine *p_vm, Object *p_object, Array<Coroutine*> &r_coroutines);
+	static bool matches(Coroutine *p_coroutine, VirtualMachine *p_vm, Object *p_object);
+
+	Array<Coroutine*> next_frame;
+	Array<Coroutine*> sleeping;		//sorted on wake time, the first one due is last
+	Array<Coroutine*> listening;
+	Array<Coroutine*> signaled;
+
+	//taken out of the lists above for the current update
+	Array<Coroutine*> resuming;
+
+	static ScriptScheduler *singleton;
+};
@@ -1,10 +1,22 @@
 #include "TitanScript.h"
 
 #include "core/ContentManager.h"
+#include "Compiler.h"
+#include "Optimizer.h"
+#include "Resolver.h"
+#include "ScriptScheduler.h"
 
 TitanScript::TitanScript()
 {
 	state = new State;
+	vm = NULL;
+	arena = NULL;
+	parsed_size = 0;
+	prototype = NULL;
+	execution_mode = EXECUTE_BYTECODE;
+	local_update = false;
+	callbacks_version = -1;
+	users = 1;
 }
 
 TitanScript::TitanScript(const String& p_file_name) : TitanScript()
@@ -17,12 +29,189 @@ void TitanScript::open_file(const String& filepath)
 	StringUtils::Init();
 
 	set_file(filepath);
+	state->name = filepath;
 
 	textfile = CONTENT->LoadTextFile(filepath);
 
-	lexer = new Lexer(textfile->get_source());
-	parser = new Parser(state, lexer->root);
+	arena = new ScriptArena;
+
+	{
+		ScriptArena::Scope scope(arena);
+
+		lexer = new Lexer(textfile->get_source());
+		parser = new Parser(state, lexer->root);
+	}
+
+	parsed_size = arena->get_size();
 	exe = new Executer(lexer->root, state);
+
+	Compiler(exe->state).compile_all(lexer->root);
+	vm = new VirtualMachine(exe->state);
+}
+
+void TitanScript::reload(const String &p_source)
+{
+	//suspended frames point into the functions that are about to be recompiled
+	SCHEDULER->cancel(vm);
+
+	//replaced lines stay in the arena until it is released, start over once they take up most of it
+	TitanScript *owner = get_prototype();
+	ScriptArena *old_arena = owner->arena;
+	bool compact = old_arena->get_size() > 2 * owner->parsed_size;
+
+	if (compact)
+		owner->arena = new ScriptArena;
+
+	ScriptArena::Scope scope(owner->arena);
+
+	Lexer *new_lexer = new Lexer(p_source);
+	Line &root = new_lexer->root;
+	Line &old_root = lexer->root;
+
+	//old units by source, identical units are matched in order
+	Dictionary<String, Array<int>> old_units;
+	Array<int> matches, reused, identical;
+	bool reparse_all = compact;
+
+	for (int c = 0; c < old_root.sub.size(); c++)
+	{
+		if (!is_branch(*old_root.sub[c]))
+			old_units[get_unit_source(old_root, c)].push_back(c);
+
+		reused.push_back(0);
+	}
+
+	for (int c = 0; c < root.sub.size(); c++)
+	{
+		matches.push_back(-1);
+		identical.push_back(0);
+
+		if (is_branch(*root.sub[c]))
+			continue;
+
+		Array<int> &candidates = old_units[get_unit_source(root, c)];
+
+		if (candidates.size() > 0)
+		{
+			matches.set(c, candidates[0]);
+			identical.set(c, 1);
+			reused.set(candidates[0], 1);
+			candidates.clear(0);
+		}
+		else if (is_declaration(*root.sub[c]))
+			reparse_all = true;
+	}
+
+	for (int c = 0; c < old_root.sub.size(); c++)
+		if (!reused[c] && !is_branch(*old_root.sub[c]) && is_declaration(*old_root.sub[c]))
+			reparse_all = true;
+
+	//definitions and the extended type affect every line after them, identical units are
+	//parsed again but not executed again
+	if (reparse_all)
+	{
+		for (int c = 0; c < matches.size(); c++)
+			matches.set(c, -1);
+
+		for (int c = 0; c < reused.size(); c++)
+			reused.set(c, 0);
+	}
+
+	//functions that were edited or deleted
+	for (int c = 0; c < old_root.sub.size(); c++)
+	{
+		ScriptNode *node = old_root.sub[c]->node;
+
+		if (!reused[c] && node && node->type == ScriptNode::FUNCTIONINIT)
+			exe->state->RemoveFunc(reinterpret_cast<FunctionInit*>(node)->name);
+	}
+
+	Array<int> changed;
+
+	for (int c = 0; c < root.sub.size(); c++)
+	{
+		if (is_branch(*root.sub[c]))
+			continue;
+
+		int size = get_unit_size(root, c);
+
+		if (matches[c] != -1)											//Take over the parsed lines
+		{
+			for (int i = 0; i < size; i++)
+				root.sub.set(c + i, old_root.sub[matches[c] + i]);
+		}
+		else
+			changed.push_back(c);
+	}
+
+	if (reparse_all)
+		*parser = Parser(state, root);
+	else
+	{
+		for (int c = 0; c < changed.size(); c++)
+			for (int i = 0; i < get_unit_size(root, changed[c]); i++)
+				parser->parse_line(root, changed[c] + i);
+
+		//the scope of a name can change anywhere in the script
+		Resolver().resolve(root);
+
+		Optimizer optimizer;
+		for (int c = 0; c < changed.size(); c++)
+			optimizer.optimize(root.sub[changed[c]]);
+	}
+
+	//unchanged globals keep their values, after a full parse the functions are defined again
+	for (int c = 0; c < changed.size(); c++)
+	{
+		ScriptNode *node = root.sub[changed[c]]->node;
+
+		if (!identical[changed[c]] || (node && node->type == ScriptNode::FUNCTIONINIT))
+			exe->Execute(node);
+	}
+
+	//slots and call targets may have moved, compiling is cheap next to parsing
+	Compiler(exe->state).compile_all(root);
+
+	//instances share the lexer, so it stays in place
+	lexer->root.sub = root.sub;
+	delete new_lexer;
+
+	if (compact)
+	{
+		delete old_arena;
+		owner->parsed_size = owner->arena->get_size();
+	}
+}
+
+bool TitanScript::is_branch(const Line &p_line)
+{
+	return p_line.size() > 0 && (p_line.StartsWith("else") || p_line.StartsWith("elseif"));
+}
+
+bool TitanScript::is_declaration(const Line &p_line)
+{
+	return p_line.size() > 0 && (p_line.StartsWith("define") || p_line.StartsWith("extends"));
+}
+
+int TitanScript::get_unit_size(const Line &p_root, int p_index)
+{
+	int size = 1;
+
+	while (p_index + size < p_root.sub.size() && is_branch(*p_root.sub[p_index + size]))
+		size++;
+
+	return size;
+}
+
+String TitanScript::get_unit_source(const Line &p_root, int p_index)
+{
+	String source;
+	int size = get_unit_size(p_root, p_index);
+
+	for (int c = 0; c < size; c++)
+		source += p_root.sub[p_index + c]->get_source() + "\n";
+
+	return source;
 }
 
 TitanScript* TitanScript::CreateNewInstance()
@@ -34,8 +223,14 @@ TitanScript* TitanScript::CreateNewInstance()
 	newscript->parser = parser;
 	newscript->textfile = textfile;
 	newscript->exe = exe;
+	newscript->vm = vm;
+	newscript->prototype = get_prototype();
+	newscript->prototype->users++;
+	newscript->execution_mode = execution_mode;
+	newscript->local_update = local_update;
 
 	newscript->state = new State;
+	newscript->state->name = state->name;
 
 	Extend(ext);
 	return newscript;
@@ -52,25 +247,123 @@ bool TitanScript::FunctionExists(const StringName& name)
 	return exe->state->FuncExists(name);
 }
 
+void TitanScript::set_execution_mode(ExecutionMode p_mode)
+{
+	execution_mode = p_mode;
+}
+
+TitanScript::ExecutionMode TitanScript::get_execution_mode() const
+{
+	return execution_mode;
+}
+
+void TitanScript::set_local_update(bool p_local_update)
+{
+	local_update = p_local_update;
+}
+
+bool TitanScript::get_local_update() const
+{
+	return local_update;
+}
+
+bool TitanScript::can_run_parallel(const StringName &name)
+{
+	if (!local_update || execution_mode != EXECUTE_BYTECODE || !exe->state->FuncExists(name))
+		return false;
+
+	return exe->state->GetFunc(name)->compiled != NULL;
+}
+
+VirtualMachine* TitanScript::get_virtual_machine() const
+{
+	return vm;
+}
+
+String TitanScript::dump_tree() const
+{
+	return Optimizer::dump(lexer->root);
+}
+
 Variant TitanScript::RunFunction(const StringName& name)
 {
-	return exe->run_titan_func(name, Array<Variant>());
+	return RunFunction(name, Arguments());
 }
 
-Variant TitanScript::RunFunction(const StringName& name, const Array<Variant>& paras)
+Variant TitanScript::RunFunction(const StringName& name, const Arguments& paras)
 {
+	if (execution_mode == EXECUTE_BYTECODE && exe->state->FuncExists(name))
+		return run(exe->state->GetFunc(name), paras);
+
 	return exe->run_titan_func(name, paras);
 }
 
+Variant TitanScript::run(Function *p_function, const Arguments &paras)
+{
+	if (execution_mode == EXECUTE_BYTECODE && p_function->compiled)
+		return vm->run(p_function->compiled, paras, state->extension);
+
+	return exe->run_titan_func(p_function, paras);
+}
+
+bool TitanScript::implements(Lifecycle p_callback)
+{
+	if (callbacks_version != exe->state->get_func_version())
+		update_callbacks();
+
+	return callbacks[p_callback] != NULL;
+}
+
+Variant TitanScript::run_callback(Lifecycle p_callback, const Arguments &paras)
+{
+	if (!implements(p_callback))
+		return NULL_VAR;
+
+	return run(callbacks[p_callback], paras);
+}
+
+void TitanScript::update_callbacks()
+{
+	State *functions = exe->state;
+
+	for (int c = 0; c < LIFECYCLE_COUNT; c++)
+	{
+		StringName name = MethodMaster::get_lifecycle_name(static_cast<Lifecycle>(c));
+		callbacks[c] = functions->FuncExists(name) ? functions->GetFunc(name) : NULL;
+	}
+
+	callbacks_version = functions->get_func_version();
+}
+
 void TitanScript::Clean()
 {
+	TitanScript *owner = get_prototype();
+
+	//an instance only owns its State, the VirtualMachine runs on the one of the prototype
+	if (prototype)
+	{
+		state->Free();
+		delete state;
+		state = NULL;
+	}
+
+	//the last of the prototype and its instances frees what they share
+	if (--owner->users > 0)
+		return;
+
 	lexer->Free();
-	state->Free();
+	owner->state->Free();
+
+	SCHEDULER->cancel(vm);
 
+	delete vm;
 	delete exe;
 	delete lexer;
 	delete parser;
-	delete state;
+	delete owner->arena;
+	owner->arena = NULL;
+	delete owner->state;
+	owner->state = NULL;
 }
 
 #undef CLASSNAME
@@ -82,4 +375,7 @@ void TitanScript::bind_methods()
 	REG_CSTR_OVRLD_1(String);
 
 	REG_METHOD(open_file);
+	REG_METHOD(reload);
+
+	REG_PROPERTY(local_update);
 }
@@ -6,9 +6,11 @@
 #include "Lexer.h"
 #include "Parser.h"
 #include "Executer.h"
+#include "VirtualMachine.h"
 #include "utility/StringUtils.h"
 #include "core/NodeManager.h"
 #include "resources/TextFile.h"
+#include "types/Lifecycle.h"
 
 class TitanScript : public Resource
 {
@@ -18,26 +20,81 @@ public:
 	TitanScript();
 	TitanScript(const String &p_file_name);
 
+	enum ExecutionMode
+	{
+		EXECUTE_TREE,		//walk the ScriptNode tree, kept as the reference implementation
+		EXECUTE_BYTECODE	//run the compiled functions in the VirtualMachine
+	};
+
 	void open_file(const String &filepath);
 
+	//re-lexes p_source but only parses and runs the top level lines that changed
+	void reload(const String &p_source);
+
 	TitanScript* CreateNewInstance();
 
 	void Extend(Variant ext);
 
 	bool FunctionExists(const StringName &name);
 
+	void set_execution_mode(ExecutionMode p_mode);
+	ExecutionMode get_execution_mode() const;
+
+	//marks a script whose update only changes its own object, so World can run it in parallel
+	void set_local_update(bool p_local_update);
+	bool get_local_update() const;
+
+	//whether name can run on a worker thread: a local script in bytecode mode
+	bool can_run_parallel(const StringName &name);
+
+	VirtualMachine* get_virtual_machine() const;
+
+	//the optimized ScriptNode tree as text, for debugging
+	String dump_tree() const;
+
 	Variant RunFunction(const StringName &name);
-	Variant RunFunction(const StringName &name, const Array<Variant> &paras);
+	Variant RunFunction(const StringName &name, const Arguments &paras);
+
+	//the functions for the lifecycle callbacks are looked up again when the script changed
+	bool implements(Lifecycle p_callback);
+	Variant run_callback(Lifecycle p_callback, const Arguments &paras);
 
-	//Free Memory
+	//Free Memory, the parts shared with the instances go with the last one cleaned
 	void Clean();
 
 	static void bind_methods();
 
 private:
+	//a top level line together with the else and elseif lines that belong to it
+	static bool is_branch(const Line &p_line);
+	static bool is_declaration(const Line &p_line);
+	static int get_unit_size(const Line &p_root, int p_index);
+	static String get_unit_source(const Line &p_root, int p_index);
+
+	Variant run(Function *p_function, const Arguments &paras);
+	void update_callbacks();
+
 	TextFile* textfile;
 	Lexer *lexer; 
 	Parser *parser; 
 	State *state; 
 	Executer *exe;
+	VirtualMachine *vm;
+
+	//owns the Lines and ScriptNodes, size is measured after a full parse. Instances share
+	//the one of the script they were created from, a reload can replace it
+	ScriptArena *arena;
+	size_t parsed_size;
+	TitanScript *prototype;
+
+	TitanScript* get_prototype() { return prototype ? prototype : this; }
+
+	//the prototype and the instances that are not cleaned yet, kept on the prototype
+	int users;
+
+	ExecutionMode execution_mode;
+	bool local_update;
+
+	Function *callbacks[LIFECYCLE_COUNT];
+	int callbacks_version;
 };
\ No newline at end of file
@@ -0,0 +1,377 @@
+#include "TypeInference.h"
+
+#include "types/MethodMaster.h"
+#include "Optimizer.h"
+
+//type of a local that no assignment has been seen for yet
+#define UNSEEN_TYPE -1
+
+TypeInference::TypeInference()
+{
+	changed = false;
+}
+
+void TypeInference::infer(Block *p_function)
+{
+	slot_types.clear();
+
+	for (int c = 0; c < p_function->slot_count; c++)
+		slot_types.push_back(c < p_function->params.size() ? Variant::UNDEF : UNSEEN_TYPE);
+
+	find_initialized(p_function);
+	solve(p_function);
+
+	//only assigned values that depend on each other, none of them is proven
+	bool unseen = false;
+
+	for (int c = 0; c < slot_types.size(); c++)
+	{
+		if (slot_types[c] == UNSEEN_TYPE)
+		{
+			slot_types[c] = Variant::UNDEF;
+			unseen = true;
+		}
+	}
+
+	if (unseen)
+		solve(p_function);
+}
+
+//slot types only move from unseen to a type to unknown, so this ends
+void TypeInference::solve(Block *p_function)
+{
+	do
+	{
+		changed = false;
+		infer(p_function);
+	} while (changed);
+}
+
+//a local that is read before its first assignment holds NULL at that point. Only
+//locals whose first use is a top level assignment, or the declaration of a top level
+//for loop, keep the types of their assignments
+void TypeInference::find_initialized(Block *p_function)
+{
+	Array<int> used;
+
+	for (int c = 0; c < p_function->params.size(); c++)
+		used.push_back(c);
+
+	for (ScriptNode *line : p_function->lines)
+	{
+		ScriptNode *first = line;
+
+		if (first && first->type == ScriptNode::FOR)
+			first = reinterpret_cast<ForLoop*>(first)->decl;
+
+		if (first && first->type == ScriptNode::INIT)
+		{
+			Init *init = reinterpret_cast<Init*>(first);
+			int slot = init->var->type == ScriptNode::VARIABLE ? reinterpret_cast<VariableNode*>(init->var)->slot : -1;
+
+			Array<int> read;
+			collect_slots(init->val, read);
+
+			if (slot >= 0 && !used.contains(slot) && !read.contains(slot))
+				used.push_back(slot);
+		}
+
+		Array<int> slots;
+		collect_slots(line, slots);
+
+		for (int c = 0; c < slots.size(); c++)
+		{
+			if (!used.contains(slots[c]))
+			{
+				used.push_back(slots[c]);
+				slot_types[slots[c]] = Variant::UNDEF;
+			}
+		}
+	}
+}
+
+//=========================================================================
+//Expressions
+//=========================================================================
+
+int TypeInference::infer(ScriptNode *p_node)
+{
+	if (!p_node)
+		return Variant::UNDEF;
+
+	int type = Variant::UNDEF;
+
+	switch (p_node->type)
+	{
+	case ScriptNode::CONSTANT:
+	{
+		int value_type = reinterpret_cast<Constant*>(p_node)->value.type;
+
+		if (is_value_type(value_type))
+			type = value_type;
+		break;
+	}
+
+	case ScriptNode::VARIABLE:
+	{
+		int slot = reinterpret_cast<VariableNode*>(p_node)->slot;
+
+		if (slot >= 0)
+			type = slot_types[slot];
+		break;
+	}
+
+	case ScriptNode::SUPERVAR:
+	{
+		Property *property = reinterpret_cast<SuperVariable*>(p_node)->property;
+
+		if (property)
+			type = get_value_type(property->var_type);
+		break;
+	}
+
+	case ScriptNode::PARENTHESES:
+		type = infer(reinterpret_cast<Parentheses*>(p_node)->node);
+		break;
+
+	case ScriptNode::PATH:
+		type = infer_path(reinterpret_cast<Path*>(p_node));
+		break;
+
+	case ScriptNode::SUM:
+	{
+		Sum *sum = reinterpret_cast<Sum*>(p_node);
+		int left = infer(sum->left);
+		int right = infer(sum->right);
+
+		type = get_arithmetic_type(sum->op, left, right);
+		break;
+	}
+
+	case ScriptNode::PRODUCT:
+	{
+		Product *pro = reinterpret_cast<Product*>(p_node);
+		int left = infer(pro->left);
+		int right = infer(pro->right);
+
+		type = get_arithmetic_type(pro->op, left, right);
+		break;
+	}
+
+	case ScriptNode::COMPARISON:
+	case ScriptNode::NOT:
+	case ScriptNode::OR:								//the VM turns both outcomes into a bool
+		infer_children(p_node);
+		type = Variant::BOOL;
+		break;
+
+	case ScriptNode::AND:								//false, or the value of the right side
+	{
+		And *a = reinterpret_cast<And*>(p_node);
+		infer(a->left);
+
+		if (infer(a->right) == Variant::BOOL)
+			type = Variant::BOOL;
+		break;
+	}
+
+	case ScriptNode::ORIENTATION:
+	{
+		Orientation *o = reinterpret_cast<Orientation*>(p_node);
+		int right = infer(o->right);
+
+		//negating a vector multiplies it with -1.0
+		if (!o->negate || right == UNSEEN_TYPE)
+			type = right;
+		else if (right == Variant::INT || right == Variant::FLOAT)
+			type = right;
+		else
+			type = get_arithmetic_type(Variant::MULTIPLY, right, Variant::FLOAT);
+		break;
+	}
+
+	case ScriptNode::INIT:
+	{
+		Init *init = reinterpret_cast<Init*>(p_node);
+
+		type = infer(init->val);
+		store(init->var, type);
+		break;
+	}
+
+	case ScriptNode::MODIFY:
+	{
+		Modify *mod = reinterpret_cast<Modify*>(p_node);
+		int value = infer(mod->val);
+
+		type = get_arithmetic_type(mod->op, infer(mod->var), value);
+		store(mod->var, type);
+		break;
+	}
+
+	case ScriptNode::CHANGEONE:
+	{
+		ChangeOne *one = reinterpret_cast<ChangeOne*>(p_node);
+
+		type = get_arithmetic_type(one->op, infer(one->var), Variant::INT);
+		store(one->var, type);
+		break;
+	}
+
+	case ScriptNode::CONSTRUCTOR:
+	{
+		Constructor *cstr = reinterpret_cast<Constructor*>(p_node);
+		VariantType constructed = VariantType(cstr->name);
+
+		infer_children(p_node);
+
+		if (MMASTER->get_constructor(constructed, cstr->params.size()))
+			type = get_value_type(constructed);
+		break;
+	}
+
+	case ScriptNode::STATICFUNC:
+	{
+		StaticFuncCall *call = reinterpret_cast<StaticFuncCall*>(p_node);
+
+		infer_children(p_node);
+
+		if (MMASTER->static_funcs.contains(call->name))
+			type = get_return_type(MMASTER->static_funcs[call->name]);
+		break;
+	}
+
+	default:
+		infer_children(p_node);
+		break;
+	}
+
+	p_node->result_type = type == UNSEEN_TYPE ? Variant::UNDEF : type;
+	return type;
+}
+
+int TypeInference::infer_path(Path *p_path)
+{
+	int type = infer(p_path->origin->node);
+
+	//members of objects depend on the runtime type, only value types are followed
+	for (ScriptNode *n : p_path->path)
+	{
+		if (n->type == ScriptNode::MEMBERFUNC)
+		{
+			MemberFunc *mf = reinterpret_cast<MemberFunc*>(n);
+			Method *m = is_value_type(type) ? MMASTER->get_method(VariantType(type), mf->method_name) : NULL;
+
+			infer_children(n);
+			type = m ? get_return_type(m) : Variant::UNDEF;
+		}
+		else if (n->type == ScriptNode::MEMBERVAR)
+		{
+			MemberVar *mv = reinterpret_cast<MemberVar*>(n);
+			Property *p = is_value_type(type) ? MMASTER->get_property(VariantType(type), mv->variable_name) : NULL;
+
+			type = p ? get_value_type(p->var_type) : Variant::UNDEF;
+		}
+		else
+			type = Variant::UNDEF;
+
+		n->result_type = type;
+	}
+
+	return type;
+}
+
+void TypeInference::infer_children(ScriptNode *p_node)
+{
+	Array<ScriptNode*> children = Optimizer::get_children(p_node);
+
+	for (int c = 0; c < children.size(); c++)
+		infer(children[c]);
+}
+
+void TypeInference::store(ScriptNode *p_target, int p_type)
+{
+	if (!p_target || p_target->type != ScriptNode::VARIABLE)
+	{
+		infer(p_target);
+		return;
+	}
+
+	int slot = reinterpret_cast<VariableNode*>(p_target)->slot;
+
+	if (slot < 0 || p_type == UNSEEN_TYPE)
+		return;
+
+	int &current = slot_types[slot];
+
+	if (current == UNSEEN_TYPE)
+	{
+		current = p_type;
+		changed = true;
+	}
+	else if (current != p_type && current != Variant::UNDEF)
+	{
+		current = Variant::UNDEF;
+		changed = true;
+	}
+}
+
+//=========================================================================
+//Helpers
+//=========================================================================
+
+void TypeInference::collect_slots(ScriptNode *p_node, Array<int> &r_slots)
+{
+	if (!p_node)
+		return;
+
+	if (p_node->type == ScriptNode::VARIABLE)
+	{
+		int slot = reinterpret_cast<VariableNode*>(p_node)->slot;
+
+		if (slot >= 0)
+			r_slots.push_back(slot);
+	}
+
+	Array<ScriptNode*> children = Optimizer::get_children(p_node);
+
+	for (int c = 0; c < children.size(); c++)
+		collect_slots(children[c], r_slots);
+}
+
+//the combinations the VM has a typed opcode for, the result type matches Variant::operate
+int TypeInference::get_arithmetic_type(Variant::OperatorType p_op, int p_left, int p_right)
+{
+	if (p_left == UNSEEN_TYPE || p_right == UNSEEN_TYPE)
+		return UNSEEN_TYPE;
+
+	bool vector = p_left == Variant::VEC2 || p_left == Variant::VEC3 || p_left == Variant::VEC4;
+
+	if (p_left == p_right && (p_left == Variant::INT || p_left == Variant::FLOAT || vector))
+		return p_left;
+
+	if (vector && p_right == Variant::FLOAT)
+		return p_left;
+
+	return Variant::UNDEF;
+}
+
+int TypeInference::get_return_type(Method *p_method)
+{
+	if (!p_method->returns_variant)
+		return Variant::UNDEF;
+
+	return get_value_type(static_cast<ReturnMethod*>(p_method)->return_type);
+}
+
+int TypeInference::get_value_type(const VariantType &p_type)
+{
+	int type = static_cast<Variant::Type>(p_type);
+
+	return is_value_type(type) ? type : Variant::UNDEF;
+}
+
+bool TypeInference::is_value_type(int p_type)
+{
+	return p_type >= Variant::BOOL && p_type <= Variant::TRANSFORM;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "core/Data.h"
+
+struct Method;
+
+//Infers the Variant::Type of the expressions in a function body, the Compiler emits
+//typed opcodes for the arithmetic and comparisons whose operand types are proven.
+//Types come from literals, value constructors and the return types registered in the
+//MethodMaster. A local has a type when it is assigned before any other use and every
+//assignment stores that type, parameters and globals are never typed.
+class TypeInference
+{
+public:
+	TypeInference();
+
+	//writes ScriptNode::result_type for the expressions of p_function
+	void infer(Block *p_function);
+
+private:
+	void solve(Block *p_function);
+	void find_initialized(Block *p_function);
+
+	int infer(ScriptNode *p_node);
+	int infer_path(Path *p_path);
+	void infer_children(ScriptNode *p_node);
+	void store(ScriptNode *p_target, int p_type);
+
+	static void collect_slots(ScriptNode *p_node, Array<int> &r_slots);
+
+	static int get_arithmetic_type(Variant::OperatorType p_op, int p_left, int p_right);
+	static int get_return_type(Method *p_method);
+	static int get_value_type(const VariantType &p_type);
+	static bool is_value_type(int p_type);
+
+	Array<int> slot_types;
+	bool changed;
+};
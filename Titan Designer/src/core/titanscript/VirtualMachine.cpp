@@ -0,0 +1,582 @@
+#include "VirtualMachine.h"
+
+#include "Executer.h"
+#include "ScriptScheduler.h"
+#include "CommandBuffer.h"
+#include "ScriptProfiler.h"
+#include "types/MethodMaster.h"
+
+thread_local Array<Variant> VirtualMachine::stack;
+thread_local int VirtualMachine::top = 0;
+thread_local Variant VirtualMachine::self;
+
+VirtualMachine::VirtualMachine(State *p_state)
+{
+	state = p_state;
+	shared = false;
+}
+
+Variant VirtualMachine::run(CompiledFunction *p_function, const Arguments &p_args, const Variant &p_self)
+{
+	int base = top;
+	reserve_frame(base + p_args.size());
+
+	for (int c = 0; c < p_args.size(); c++)
+		stack[base + c] = p_args[c];
+
+	//a native call can run the script of another object on this thread
+	Variant previous_self = self;
+	self = p_self;
+
+	Variant result = execute(p_function, base, p_args.size(), true);
+
+	self = previous_self;
+	return result;
+}
+
+Variant VirtualMachine::resume(Coroutine *p_coroutine)
+{
+	CompiledFunction *function = p_coroutine->function;
+	int base = top;
+	reserve_frame(base + function->register_count);
+
+	for (int c = 0; c < function->register_count; c++)
+		stack[base + c] = p_coroutine->registers[c];
+
+	stack[base + p_coroutine->result_register] = p_coroutine->value;
+
+	Variant previous_self = self;
+	self = p_coroutine->self;
+
+	Variant result = run_frame(function, base, p_coroutine->pc, true);
+
+	self = previous_self;
+	return result;
+}
+
+void VirtualMachine::set_shared(bool p_shared)
+{
+	shared = p_shared;
+}
+
+void VirtualMachine::reserve_frame(int p_end)
+{
+	if (stack.size() < p_end)
+		stack.resize(p_end);
+}
+
+Variant VirtualMachine::call(const CallSite &p_site, int p_base)
+{
+	Function *target = p_site.target;
+
+	if (!target && state->FuncExists(p_site.name))					//Defined after compilation
+		target = state->GetFunc(p_site.name);
+
+	if (target && target->compiled)
+		return execute(target->compiled, p_base, p_site.arg_count);
+	else if (p_site.name == CORE_NAMES->print && p_site.arg_count > 0)
+		T_LOG(stack[p_base].ToString());
+	else
+		SCRIPT_ERROR("Function: " + p_site.name.get_source() + " does not exist!");
+
+	return NULL_VAR;
+}
+
+Variant VirtualMachine::call_native(Method *p_method, int p_first, int p_arg_count, int p_base)
+{
+	if (p_arg_count > MAX_METHOD_ARGS)
+	{
+		SCRIPT_ERROR("Too many arguments for method: " + p_method->name.get_source());
+		return NULL_VAR;
+	}
+
+	//the method can re-enter the VM and move the stack, so it gets a copy of the arguments
+	Variant args[MAX_METHOD_ARGS];
+
+	for (int c = 0; c < p_arg_count; c++)
+		args[c] = stack[p_base + p_first + c];
+
+	Variant result = Executer::run_method(p_method, args, p_arg_count);
+
+	//a receiver stored inline was changed in the copy, the compiler writes the register back to its origin
+	if (p_arg_count > 0 && args[0].is_inline())
+		stack[p_base + p_first] = args[0];
+
+	return result;
+}
+
+bool VirtualMachine::is_foreign(const Variant &p_object) const
+{
+	return p_object.type == Variant::OBJECT && p_object.o != self.o;
+}
+
+Variant VirtualMachine::execute(CompiledFunction *p_function, int p_base, int p_arg_count, bool p_entry)
+{
+	if (p_arg_count != p_function->param_count)
+	{
+		SCRIPT_ERROR("Number of arguments does not match");
+		return NULL_VAR;
+	}
+
+	reserve_frame(p_base + p_function->register_count);
+
+	for (int c = p_arg_count; c < p_function->slot_count; c++)	//Locals start undefined
+		stack[p_base + c] = NULL_VAR;
+
+	return run_frame(p_function, p_base, 0, p_entry);
+}
+
+Variant VirtualMachine::run_frame(CompiledFunction *p_function, int p_base, int p_pc, bool p_entry)
+{
+	int previous_top = top;
+	top = p_base + p_function->register_count;
+	reserve_frame(top);
+
+	//native calls can re-enter the VM and grow the stack, so r is refreshed after them
+	Variant *r = &stack[p_base];
+
+	const Instruction *code = &p_function->code[0];
+	Variant result;
+	int pc = p_pc;
+	bool running = true;
+
+	//read once, a profiler started halfway through the frame must not see an unmatched leave
+	bool profiled = ScriptProfiler::active;
+
+	if (profiled)
+		PROFILER->enter(state, NULL, p_function, &pc);
+
+	while (running)
+	{
+		if (profiled && ScriptProfiler::has_pending_ticks())
+			PROFILER->sample();
+
+		const Instruction &ins = code[pc++];
+
+		switch (ins.op)
+		{
+		case OP_LOAD_NULL:
+			r[ins.a] = NULL_VAR;
+			break;
+
+		case OP_LOAD_BOOL:
+			r[ins.a] = Variant(ins.b != 0);
+			break;
+
+		case OP_LOAD_INT:
+			r[ins.a] = Variant(static_cast<int>(static_cast<short>(ins.b)));
+			break;
+
+		case OP_LOAD_CONST:
+			r[ins.a] = p_function->constants[ins.b].copy();
+			break;
+
+		case OP_MOVE:
+			r[ins.a] = r[ins.b];
+			break;
+
+		case OP_GET_VAR:
+		{
+			Variant *value = state->GetVar(p_function->names[ins.b]);
+			r[ins.a] = value ? *value : NULL_VAR;
+			break;
+		}
+
+		case OP_SET_VAR:
+			if (shared && CommandBuffer::current)
+				CommandBuffer::current->set_var(state, p_function->names[ins.b], r[ins.a]);
+			else
+				state->SetVar(p_function->names[ins.b], r[ins.a]);
+			break;
+
+		case OP_GET_SUPER:
+		{
+			SuperVariable *var = reinterpret_cast<SuperVariable*>(p_function->nodes[ins.b]);
+			Variant value = var->property->get->operator()(self);
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_SET_SUPER:
+		{
+			SuperVariable *var = reinterpret_cast<SuperVariable*>(p_function->nodes[ins.b]);
+			var->property->set->operator()(self, r[ins.a]);
+
+			r = &stack[p_base];
+			break;
+		}
+
+		case OP_GET_MEMBER:
+		{
+			MemberVar *memvar = reinterpret_cast<MemberVar*>(p_function->nodes[ins.c]);
+			Variant object = r[ins.b];
+
+			if (!object.isdef())
+			{
+				SCRIPT_ERROR("Path error");
+				r[ins.a] = NULL_VAR;
+				break;
+			}
+
+			Property *p = memvar->get_property(object);
+
+			if (!p)
+			{
+				SCRIPT_ERROR("Path error");
+				r[ins.a] = NULL_VAR;
+				break;
+			}
+
+			Variant value = p->get->operator()(object);
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_SET_MEMBER:
+		{
+			MemberVar *memvar = reinterpret_cast<MemberVar*>(p_function->nodes[ins.c]);
+			Property *p = memvar->get_property(r[ins.a]);
+
+			if (!p)
+				SCRIPT_ERROR("Property does not exist");
+			else if (CommandBuffer::current && is_foreign(r[ins.a]))
+			{
+				Variant args[] = { r[ins.a], r[ins.b] };
+				CommandBuffer::current->call(p->set, args, 2);
+			}
+			else
+			{
+				Variant args[] = { r[ins.a], r[ins.b] };
+				Variant result;
+				p->set->call(args, result);
+
+				r = &stack[p_base];
+
+				//the setter changed a copy of an inline value
+				if (args[0].is_inline())
+					r[ins.a] = args[0];
+			}
+
+			r = &stack[p_base];
+			break;
+		}
+
+		case OP_GET_SELF:
+			r[ins.a] = self;
+			break;
+
+		case OP_ADD:
+			r[ins.a] = r[ins.b] + r[ins.c];
+			break;
+
+		case OP_SUBTRACT:
+			r[ins.a] = r[ins.b] - r[ins.c];
+			break;
+
+		case OP_MULTIPLY:
+			r[ins.a] = r[ins.b] * r[ins.c];
+			break;
+
+		case OP_DIVIDE:
+			r[ins.a] = r[ins.b] / r[ins.c];
+			break;
+
+		case OP_LESS:
+			r[ins.a] = Variant(r[ins.b] < r[ins.c]);
+			break;
+
+		case OP_GREATER:
+			r[ins.a] = Variant(r[ins.b] > r[ins.c]);
+			break;
+
+		case OP_LEQUAL:
+			r[ins.a] = Variant(r[ins.b] <= r[ins.c]);
+			break;
+
+		case OP_GEQUAL:
+			r[ins.a] = Variant(r[ins.b] >= r[ins.c]);
+			break;
+
+		case OP_EQUAL:
+			r[ins.a] = Variant(r[ins.b] == r[ins.c]);
+			break;
+
+		case OP_NOTEQUAL:
+			r[ins.a] = Variant(r[ins.b] != r[ins.c]);
+			break;
+
+		case OP_NOT:
+			r[ins.a] = !r[ins.b];
+			break;
+
+		case OP_NEGATE:
+		{
+			Variant value = r[ins.b];
+
+			if (value.type == Variant::INT)
+				r[ins.a] = Variant(-value.i);
+			else if (value.type == Variant::FLOAT)
+				r[ins.a] = Variant(-value.f);
+			else
+				r[ins.a] = value * Variant(-1.0f);
+			break;
+		}
+
+//typed operations skip the dispatch of Variant::operate, the Compiler proved the operand types
+#define TYPED_OPERATION(OP, EXPRESSION) \
+		case OP: \
+			r[ins.a] = Variant(EXPRESSION); \
+			break;
+
+#define TYPED_ARITHMETIC(SUFFIX, LEFT, RIGHT) \
+		TYPED_OPERATION(OP_ADD_##SUFFIX, LEFT + RIGHT) \
+		TYPED_OPERATION(OP_SUBTRACT_##SUFFIX, LEFT - RIGHT) \
+		TYPED_OPERATION(OP_MULTIPLY_##SUFFIX, LEFT * RIGHT) \
+		TYPED_OPERATION(OP_DIVIDE_##SUFFIX, LEFT / RIGHT)
+
+#define TYPED_COMPARISON(SUFFIX, LEFT, RIGHT) \
+		TYPED_OPERATION(OP_LESS_##SUFFIX, LEFT < RIGHT) \
+		TYPED_OPERATION(OP_GREATER_##SUFFIX, LEFT > RIGHT) \
+		TYPED_OPERATION(OP_LEQUAL_##SUFFIX, LEFT <= RIGHT) \
+		TYPED_OPERATION(OP_GEQUAL_##SUFFIX, LEFT >= RIGHT)
+
+		TYPED_ARITHMETIC(INT, r[ins.b].i, r[ins.c].i)
+		TYPED_ARITHMETIC(FLOAT, r[ins.b].f, r[ins.c].f)
+		TYPED_ARITHMETIC(VEC2, r[ins.b].v2, r[ins.c].v2)
+		TYPED_ARITHMETIC(VEC3, r[ins.b].v3, r[ins.c].v3)
+		TYPED_ARITHMETIC(VEC4, r[ins.b].v4, r[ins.c].v4)
+		TYPED_ARITHMETIC(VEC2_FLOAT, r[ins.b].v2, r[ins.c].f)
+		TYPED_ARITHMETIC(VEC3_FLOAT, r[ins.b].v3, r[ins.c].f)
+		TYPED_ARITHMETIC(VEC4_FLOAT, r[ins.b].v4, r[ins.c].f)
+
+		TYPED_COMPARISON(INT, r[ins.b].i, r[ins.c].i)
+		TYPED_COMPARISON(FLOAT, r[ins.b].f, r[ins.c].f)
+
+#undef TYPED_COMPARISON
+#undef TYPED_ARITHMETIC
+#undef TYPED_OPERATION
+
+		case OP_JUMP:
+			pc = ins.a;
+			break;
+
+		case OP_JUMP_IF_FALSE:
+		{
+			bool go = r[ins.a];
+			if (!go)
+				pc = ins.b;
+			break;
+		}
+
+		case OP_JUMP_IF_TRUE:
+		{
+			bool go = r[ins.a];
+			if (go)
+				pc = ins.b;
+			break;
+		}
+
+		case OP_JUMP_IF_NOT_INLINE:
+			if (!r[ins.a].is_inline())
+				pc = ins.b;
+			break;
+
+		case OP_JUMP_IF_CONST_CALL:
+		{
+			Method *m = reinterpret_cast<MemberFunc*>(p_function->nodes[ins.c])->get_method(r[ins.a]);
+
+			if (!m || m->is_const)
+				pc = ins.b;
+			break;
+		}
+
+		case OP_ARRAY_PUSH:
+			r[ins.a].push_back(r[ins.b]);
+			break;
+
+		case OP_INDEX:
+			r[ins.a] = r[ins.b][r[ins.c]];
+			break;
+
+		case OP_COMPOSE:
+		{
+			Array<Variant> values;
+			values.reserve(ins.c);
+
+			for (int c = 0; c < ins.c; c++)
+				values.push_back(r[ins.b + c]);
+
+			r[ins.a] = values;
+			break;
+		}
+
+		case OP_CONSTRUCT:
+		{
+			Constructor *cstr = reinterpret_cast<Constructor*>(p_function->nodes[ins.c]);
+			TConstructor *tc = MMASTER->get_constructor(cstr->name, cstr->params.size());
+			Variant value;
+
+			if (!tc)
+			{
+				SCRIPT_ERROR("Invalid constructor");
+				r[ins.a] = NULL_VAR;
+				break;
+			}
+
+			if (CommandBuffer::current && VariantType(cstr->name).is_object_type())
+			{
+				SCRIPT_ERROR("Objects cannot be created in a parallel update: " + cstr->name.get_source());
+				r[ins.a] = NULL_VAR;
+				break;
+			}
+
+			//the constructor can re-enter the VM and move the stack, so it gets a copy of the arguments
+			Variant args[MAX_METHOD_ARGS];
+
+			for (int c = 0; c < cstr->params.size() && c < MAX_METHOD_ARGS; c++)
+				args[c] = r[ins.b + c];
+
+			switch (cstr->params.size())
+			{
+			case 0:
+				value = reinterpret_cast<CSTR_0*>(tc)->operator()();
+				break;
+			case 1:
+				value = reinterpret_cast<CSTR_1*>(tc)->operator()(args[0]);
+				break;
+			case 2:
+				value = reinterpret_cast<CSTR_2*>(tc)->operator()(args[0], args[1]);
+				break;
+			case 3:
+				value = reinterpret_cast<CSTR_3*>(tc)->operator()(args[0], args[1], args[2]);
+				break;
+			case 4:
+				value = reinterpret_cast<CSTR_4*>(tc)->operator()(args[0], args[1], args[2], args[3]);
+				break;
+			default:
+				SCRIPT_ERROR("Invalid constructor");
+			}
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_SINGLETON:
+		{
+			TypeSpecifier *ts = reinterpret_cast<TypeSpecifier*>(p_function->nodes[ins.b]);
+			r[ins.a] = MMASTER->get_singleton(ts->referenced_type);
+			break;
+		}
+
+		case OP_CALL:
+		{
+			Variant value = call(p_function->call_sites[ins.c], p_base + ins.b);
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_CALL_STATIC:
+		{
+			StaticFuncCall *sfc = reinterpret_cast<StaticFuncCall*>(p_function->nodes[ins.c]);
+			Variant value;
+
+			if (MMASTER->static_funcs.contains(sfc->name))
+			{
+				value = call_native(MMASTER->static_funcs[sfc->name], ins.b, sfc->params.size(), p_base);
+			}
+			else
+				SCRIPT_ERROR("Static function: " + sfc->name.get_source() + " does not exist!");
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_CALL_SUPER:
+		{
+			SuperFunction *sf = reinterpret_cast<SuperFunction*>(p_function->nodes[ins.c]);
+			Method *m = sf->get_method(self);
+			Variant value;
+
+			if (m)
+			{
+				value = call_native(m, ins.b, sf->params.size() + 1, p_base);
+			}
+			else
+				SCRIPT_ERROR("Could not find method: " + sf->name);
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_CALL_MEMBER:
+		{
+			MemberFunc *mf = reinterpret_cast<MemberFunc*>(p_function->nodes[ins.c]);
+			Method *m = mf->get_method(r[ins.b]);
+			Variant value;
+
+			if (!m)
+				SCRIPT_ERROR("Could not find method: " + mf->method_name);
+			else if (CommandBuffer::current && !m->is_const && is_foreign(r[ins.b]))
+				CommandBuffer::current->call(m, &r[ins.b], mf->args.size() + 1);
+			else
+				value = call_native(m, ins.b, mf->args.size() + 1, p_base);
+
+			r = &stack[p_base];
+			r[ins.a] = value;
+			break;
+		}
+
+		case OP_YIELD:
+		{
+			if (!p_entry)
+			{
+				SCRIPT_ERROR("Only functions called by the engine can yield: " + p_function->name.get_source());
+				r[ins.a] = NULL_VAR;
+				break;
+			}
+
+			Coroutine *coroutine = new Coroutine;
+			coroutine->vm = this;
+			coroutine->function = p_function;
+			coroutine->self = self;
+			coroutine->owner = self.type == Variant::OBJECT ? self.o : NULL;
+			coroutine->pc = pc;
+			coroutine->result_register = ins.a;
+			coroutine->registers = Array<Variant>::build_array(r, p_function->register_count);
+
+			SCHEDULER->park(coroutine, static_cast<Yield::WaitType>(ins.c), r + ins.b);
+			running = false;
+			break;
+		}
+
+		case OP_RETURN:
+			result = r[ins.a];
+			running = false;
+			break;
+
+		case OP_RETURN_NULL:
+			running = false;
+			break;
+
+		default:
+			SCRIPT_ERROR("Invalid opcode in function: " + p_function->name.get_source());
+			running = false;
+			break;
+		}
+	}
+
+	if (profiled)
+		PROFILER->leave();
+
+	top = previous_top;
+	return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/Data.h"
+#include "Bytecode.h"
+
+struct Coroutine;
+
+//Register based interpreter for functions lowered by the Compiler. The registers live on
+//a stack per thread, so the instances of a script can run one VirtualMachine on several
+//workers at once
+class VirtualMachine
+{
+public:
+	VirtualMachine(State *p_state);
+
+	//p_self is the object the script extends, it differs between the instances of a script
+	Variant run(CompiledFunction *p_function, const Arguments &p_args, const Variant &p_self);
+
+	//continue a function that was suspended by a yield
+	Variant resume(Coroutine *p_coroutine);
+
+	//set by World while several objects of a parallel update run this VirtualMachine, their
+	//writes to the globals of the shared State are applied after the batch
+	void set_shared(bool p_shared);
+
+	State *state;
+
+private:
+	//execute a function whose arguments are already in the registers starting at p_base,
+	//only the entry frame of a run or resume can yield
+	Variant execute(CompiledFunction *p_function, int p_base, int p_arg_count, bool p_entry = false);
+	Variant run_frame(CompiledFunction *p_function, int p_base, int p_pc, bool p_entry);
+
+	Variant call(const CallSite &p_site, int p_base);
+	Variant call_native(Method *p_method, int p_first, int p_arg_count, int p_base);
+
+	//another object than the one the script extends, writes to those are deferred in a parallel update
+	bool is_foreign(const Variant &p_object) const;
+
+	void reserve_frame(int p_end);
+
+	bool shared;
+
+	//frames of the VirtualMachines that run on a thread are stacked on top of each other
+	static thread_local Array<Variant> stack;
+	static thread_local int top;
+	static thread_local Variant self;
+};
@@ -1,8 +1,6 @@
 #include "Variant.h"
 
-#include "Memory.h"
-
-#include "core/Object.h"
+#include "core/Reference.h"
 #include "input/Key.h"
 #include "VariantType.h"
 
@@ -12,10 +10,6 @@ Variant::Variant()
 }
 
 //Construct with value
-Variant::Variant(const Variant &r)
-{
-	reference(r);
-}
 Variant::Variant(const VariantPtrExt &p)
 {
 	//type = p.type;
@@ -56,40 +50,38 @@ Variant::Variant(bool p_b)
 }
 Variant::Variant(const String &p_s)
 {
-	s = new String(p_s);
+	s = new VariantBox<String>(p_s);
 	type = STRING;
-	//GC->queue(*this);
 }
 Variant::Variant(const vec2 &p_v2)
 {
-	v2 = new vec2(p_v2);
+	v2 = p_v2;
 	type = VEC2;
 }
 Variant::Variant(const vec3 &p_v3)
 {
-	v3 = new vec3(p_v3);
+	v3 = p_v3;
 	type = VEC3;
 }
 Variant::Variant(const vec4 &p_v4)
 {
-	v4 = new vec4(p_v4);
+	v4 = p_v4;
 	type = VEC4;
 }
 Variant::Variant(const mat4 &p_m4)
 {
-	m4 = new mat4(p_m4);
+	m4 = new VariantBox<mat4>(p_m4);
 	type = MAT4;
 }
 Variant::Variant(const Color &p_c)
 {
-	c = new Color(p_c);
+	c = p_c;
 	type = COLOR;
 }
 Variant::Variant(const Transform &p_t)
 {
-	t = new Transform(p_t);
+	t = new VariantBox<Transform>(p_t);
 	type = TRANSFORM;
-	//GC->queue(*this);
 }
 Variant::Variant(const Array<Variant> &p_a)
 {
@@ -99,7 +91,7 @@ Variant::Variant(const Array<Variant> &p_a)
 		copy(p_a[0]);
 	else
 	{
-		a = new Array<Variant>(p_a);
+		a = new VariantBox<Array<Variant>>(p_a);
 		type = ARRAY;
 	}
 }
@@ -112,7 +104,13 @@ Variant::Variant(Object *p_g)
 	if (!o)
 		type = UNDEF;
 	else
+	{
 		type = OBJECT;
+		referenced = o->is_reference_counted();
+
+		if (referenced)
+			retain();
+	}
 }
 Variant::Variant(Real *p_r)
 {
@@ -123,45 +121,39 @@ Variant::Variant(Real *p_r)
 
 	type = p_r->t == Real::INT ? INT : FLOAT;
 }
-Variant::Variant(String *p_s)
+Variant::Variant(String *p_s) : Variant(*p_s)
 {
-	s = p_s;
-	type = STRING;
 }
 Variant::Variant(vec2 *p_v2)
 {
-	v2 = p_v2;
+	v2 = *p_v2;
 	type = VEC2;
 }
 Variant::Variant(vec3 *p_v3)
 {
-	v3 = p_v3;
+	v3 = *p_v3;
 	type = VEC3;
 }
 Variant::Variant(vec4 *p_v4)
 {
-	v4 = p_v4;
+	v4 = *p_v4;
 	type = VEC4;
 }
-Variant::Variant(mat4 *p_m4)
+Variant::Variant(mat4 *p_m4) : Variant(*p_m4)
 {
-	m4 = p_m4;
-	type = MAT4;
 }
 Variant::Variant(Color *p_c)
 {
-	c = p_c;
+	c = *p_c;
 	type = COLOR;
 }
-Variant::Variant(Transform *p_t)
+Variant::Variant(Transform *p_t) : Variant(*p_t)
 {
-	t = p_t;
-	type = TRANSFORM;
 }
 
 Variant::Variant(Array<Variant>* p_a)
 {
-	a = p_a;
+	a = new VariantBox<Array<Variant>>(*p_a);
 	type = ARRAY;
 }
 
@@ -180,175 +172,92 @@ Variant Variant::copy()
 }
 
 void Variant::clean()
+{
+	if (is_counted())
+		release();
+
+	type = UNDEF;
+}
+
+void Variant::retain() const
 {
 	switch (type)
 	{
 		case STRING:
-			delete s;
+			s->refs++;
+			break;
+		case MAT4:
+			m4->refs++;
 			break;
 		case TRANSFORM:
+			t->refs++;
 			break;
 		case ARRAY:
-			a->clear();
+			a->refs++;
 			break;
-		case VEC2:
-			delete v2;
-			break;
-
 		case OBJECT:
-
+			static_cast<Referenced*>(o)->increase_ref_count();
 			break;
 	}
-
-	type = UNDEF;
-}
-
-void Variant::free()
-{
-	switch (type)
-	{
-	case UNDEF:
-	case BOOL:
-	case INT:
-	case FLOAT:
-		break;
-	case STRING:
-		delete s;
-		break;
-	case VEC2:
-		delete v2;
-		break;
-	case VEC3:
-		delete v3;
-		break;
-	case VEC4:
-		delete v4;
-		break;
-	case MAT4:
-		delete m4;
-		break;
-	case COLOR:
-		delete c;
-		break;
-	case TRANSFORM:
-		delete t;
-		break;
-	case ARRAY:
-		delete a;
-		break;
-	case OBJECT:
-		delete o;
-		break;
-	default:
-		T_ERROR("Copy Error");
-	}
-
-	type = UNDEF;
 }
 
-void Variant::copy(const Variant &ref)
+void Variant::release()
 {
-	type = ref.type;
-
 	switch (type)
 	{
-		case UNDEF:
-			break;
-		case BOOL:
-			b = ref.b;
-			break;
-		case INT:
-			i = ref.i;
-			break;
-		case FLOAT:
-			f = ref.f;
-			break;
 		case STRING:
-			s = new String(*ref.s);
-			break;
-		case VEC2:
-			v2 = new vec2(*ref.v2);
-			break;
-		case VEC3:
-			v3 = new vec3(*ref.v3);
-			break;
-		case VEC4:
-			v4 = new vec4(*ref.v4);
+			if (--s->refs == 0)
+				delete s;
 			break;
 		case MAT4:
-			m4 = new mat4(*ref.m4);
-			break;
-		case COLOR:
-			c = new Color(*ref.c);
+			if (--m4->refs == 0)
+				delete m4;
 			break;
 		case TRANSFORM:
-			t = new Transform(*ref.t);
+			if (--t->refs == 0)
+				delete t;
 			break;
 		case ARRAY:
-			if (ref.a->size() == 0)
-				type = UNDEF;
-			else if (ref.a->size() == 1)
-				copy(ref.a[0]);
-			else
-				a = ref.a;
+			if (--a->refs == 0)
+				delete a;
 			break;
 		case OBJECT:
-			o = ref.o;
+			static_cast<Referenced*>(o)->decrease_ref_count();
 			break;
-		default:
-			T_ERROR("Copy Error");
 	}
 }
 
-void Variant::reference(const Variant &ref)
+void Variant::copy(const Variant &ref)
 {
-	type = ref.type;
-
-	switch (type)
+	switch (ref.type)
 	{
-		case UNDEF:
-			break;
-		case BOOL:
-			b = ref.b;
-			break;
-		case INT:
-			i = ref.i;
-			break;
-		case FLOAT:
-			f = ref.f;
-			break;
 		case STRING:
-			s = ref.s;
-			break;
-		case VEC2:
-			v2 = ref.v2;
-			break;
-		case VEC3:
-			v3 = ref.v3;
-			break;
-		case VEC4:
-			v4 = ref.v4;
+			*this = Variant(ref.s->value);
 			break;
 		case MAT4:
-			m4 = ref.m4;
-			break;
-		case COLOR:
-			c = ref.c;
+			*this = Variant(ref.m4->value);
 			break;
 		case TRANSFORM:
-			t = ref.t;
+			*this = Variant(ref.t->value);
 			break;
 		case ARRAY:
-			a = ref.a;
-			break;
-		case OBJECT:
-			o = ref.o;
+			if (ref.a->value.size() == 0)
+				clean();
+			else if (ref.a->value.size() == 1)
+				copy(ref.a->value[0]);
+			else
+				*this = ref;
 			break;
 		default:
-			T_ERROR("Reference Error");
+			*this = ref;
 	}
 }
 
+void Variant::reference(const Variant &ref)
+{
+	*this = ref;
+}
+
 bool Variant::isdef() const
 {
 	return type > UNDEF;
@@ -361,7 +270,17 @@ VariantType Variant::get_type() const
 	else return (Type) type;
 }
 
-bool Variant::is_ptr() const
+void* Variant::get_type_ptr() const
+{
+	static int builtin_types[ARRAY + 1];
+
+	if (type == OBJECT)
+		return o->get_type_ptr();
+	else
+		return &builtin_types[type];
+}
+
+bool Variant::is_inline() const
 {
-	return type != BOOL && type != INT && type != FLOAT;
+	return type == VEC2 || type == VEC3 || type == VEC4 || type == COLOR;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <string>
 
 #include "String.h"
@@ -20,11 +22,54 @@ struct VariantPtrExt;
 
 #define NULL_VAR Variant()
 
+//Heap storage of a boxed value. The copies of a Variant share the box, the last one
+//that lets go of it deletes it
+template<typename T>
+struct VariantBox
+{
+	VariantBox(const T &p_value) : value(p_value), refs(1) { }
+
+	T value;
+	std::atomic<int> refs;
+};
+
 class Variant
 {
 public:
 	Variant();
-	Variant(const Variant& r);
+
+	//inline values are duplicated, boxed values and Referenced objects are shared and counted
+	Variant(const Variant &r) : type(r.type), referenced(r.referenced)
+	{
+		std::memcpy(data, r.data, sizeof(data));
+
+		if (is_counted())
+			retain();
+	}
+	Variant(Variant &&r) : type(r.type), referenced(r.referenced)
+	{
+		std::memcpy(data, r.data, sizeof(data));
+		r.type = UNDEF;
+	}
+	Variant& operator=(const Variant &r)
+	{
+		Variant value(r);
+		return *this = std::move(value);
+	}
+	Variant& operator=(Variant &&r)
+	{
+		if (this == &r)
+			return *this;
+
+		//released last, r may be stored in the old value
+		Variant old(std::move(*this));
+
+		std::memcpy(data, r.data, sizeof(data));
+		type = r.type;
+		referenced = r.referenced;
+		r.type = UNDEF;
+		return *this;
+	}
 
 	//Value
 	Variant(const VariantPtrExt &p);
@@ -42,7 +87,7 @@ public:
 	Variant(const Transform &p_t);
 	Variant(const Array<Variant> &p_a);
 
-	//Reference
+	//Reference, all but the object copy the value they point to
 	Variant(Object *p_g);
 	Variant(Real *p_r);
 	Variant(String *p_s);
@@ -54,7 +99,11 @@ public:
 	Variant(Transform *p_t);
 	Variant(Array<Variant> *p_a);
 
-	~Variant() { }
+	~Variant()
+	{
+		if (is_counted())
+			release();
+	}
 
 	enum Type
 	{
@@ -95,22 +144,26 @@ public:
 		DIVIDE
 	};
 
+	//vec2, vec3, vec4 and Color are stored inline, the larger types are boxed on the heap
 	union
 	{
 		void *ptr;
 		bool b;
 		int i;
 		float f;
-		String *s;
-		vec2 *v2;
-		vec3 *v3;
-		vec4 *v4;
-		mat4 *m4;
-		Color *c;
-		Transform *t;
+		vec2 v2;
+		vec3 v3;
+		vec4 v4;
+		Color c;
+
+		VariantBox<String> *s;
+		VariantBox<mat4> *m4;
+		VariantBox<Transform> *t;
 		Object *o;
 
-		Array<Variant> *a;
+		VariantBox<Array<Variant>> *a;
+
+		unsigned char data[sizeof(vec4)];
 	};
 
 	//Memory Management
@@ -118,10 +171,8 @@ public:
 	void copy(const Variant &ref);
 	Variant reference();
 	Variant copy();
-	void clean();
+	void clean();					//lets go of the value, the Variant is undefined after
 
-	void free();
-	
 	//Operators
 	Variant operate(const int OPType, const Variant &right) const;
 
@@ -146,12 +197,22 @@ public:
 	bool operator<(const Variant &right) const;
 	bool operator<=(const Variant &right) const;
 
-	void operator=(const Variant &r);
-
 	//Methods
 	bool isdef() const;
+	//holds a box or an object, copies share it
+	bool is_ptr() const
+	{
+		return type == STRING || type == MAT4 || type == TRANSFORM || type == OBJECT || type == ARRAY;
+	}
+
+	//vec2, vec3, vec4 or Color. Changing a member of one changes only this copy,
+	//so the interpreters write it back to where it came from
+	bool is_inline() const;
 	VariantType get_type() const;
 
+	//unique per type, used as a cheap key for type based caches
+	void* get_type_ptr() const;
+
 	//Functions
 	Array<String > ListMemberFuncNames();
 	//bool FuncExists(const String  &name);
@@ -192,12 +253,13 @@ public:
 	//operator bool*() const { return b; }
 	//operator int*() const { return &i; }
 	//operator float*() const { return &f; }
-	operator String*() const { return s; }
-	operator vec2*() const { return v2; }
-	operator vec3*() const { return v3; }
-	operator vec4*() const { return v4; }
-	operator mat4*() const { return m4; }
-	operator Transform*() const { return t; }
+	operator String*() const { return &s->value; }
+	operator vec2*() const { return const_cast<vec2*>(&v2); }
+	operator vec3*() const { return const_cast<vec3*>(&v3); }
+	operator vec4*() const { return const_cast<vec4*>(&v4); }
+	operator Color*() const { return const_cast<Color*>(&c); }
+	operator mat4*() const { return &m4->value; }
+	operator Transform*() const { return &t->value; }
 
 	//best method imaginable
 	template<typename T> operator T() const
@@ -227,11 +289,11 @@ public:
 		case STRING:
 			return *s;
 		case VEC2:
-			return *v2;
+			return v2;
 		case VEC3:
-			return *v3;
+			return v3;
 		case VEC4:
-			return *v4;
+			return v4;
 		case MAT4:
 			return *m4;
 		case VEC3:
@@ -241,11 +303,20 @@ public:
 		}
 	}
 
-	int type;
+	int type = UNDEF;
+
+	//o derives from Referenced, this Variant holds one of its references
+	bool referenced = false;
 
 private:
-	bool is_ptr() const;
+	//boxes and Referenced objects, the values that are shared between copies and counted
+	bool is_counted() const
+	{
+		return type == OBJECT ? referenced : is_ptr();
+	}
 
+	void retain() const;
+	void release();
 };
 
 struct VariantPtr
@@ -9,9 +9,9 @@
 class VariantType
 {
 public:
-	VariantType() : VariantType(StringName(CORE_TYPE(Null))) { }
-	VariantType(int type) : VariantType(static_cast<Variant::Type>(type)){ }
-	VariantType(Variant::Type type);
+	VariantType() : id(Variant::UNDEF) { }
+	VariantType(int p_id) : id(p_id) { }
+	VariantType(Variant::Type type) : id(type) { }
 	VariantType(const String &name) : VariantType(StringName(name)) { }
 	VariantType(const StringName &name);
 	VariantType(ObjectTypeRef p_object_type);
@@ -29,13 +29,13 @@ public:
 	template<typename T>
 	bool is_of_type() const
 	{
-		return GETNAME(T::get_type_ptr_static()) == type_name;
+		return T::get_type_id_static() == id;
 	}
 
 	template<typename T>
 	bool derives_from_type() const
 	{
-		return TYPEMAN->get_object_type(type_name).path.Contains(T::get_type_name_static());
+		return TYPEMAN->derives_from(id, T::get_type_id_static());
 	}
 
 	//operators
@@ -50,5 +50,7 @@ public:
 
 private:
 	String get_object_typename() const;
-	StringName type_name;
+
+	//the id assigned by the TypeManager, builtin types use their Variant::Type
+	int id;
 };
\ No newline at end of file
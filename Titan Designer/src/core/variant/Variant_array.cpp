@@ -8,13 +8,13 @@ Variant Variant::GetElement(const Variant &index)
 {
 	if (index.type == Variant::INT)
 	{
-		if (index.i >= static_cast<signed int>(a->size()) || i < 0)
+		if (index.i >= static_cast<signed int>(a->value.size()) || i < 0)
 		{
 			T_ERROR("Array index out of bounds");
 			return NULL_VAR;
 		}
 		if (type == Variant::ARRAY)
-			return a->operator[](index.i);
+			return a->value[index.i];
 
 		return *this;
 	}
@@ -27,7 +27,7 @@ void Variant::clear()
 	//if (type != ARRAY)
 	//	T_ERROR("Cannot call method 'clear' on a non-array variant");
 	//else
-		a->clear();
+		a->value.clear();
 }
 
 void Variant::push_back(const Variant &var)
@@ -35,18 +35,19 @@ void Variant::push_back(const Variant &var)
 	if (type != ARRAY)
 	{
 		//Transform this into an array
+		clean();
+		a = new VariantBox<Array<Variant>>(Array<Variant>());
 		type = ARRAY;
-		a = new Array<Variant>;
 		//a.push_back(*this);
 	}
 
-	a->push_back(var);
+	a->value.push_back(var);
 }
 
 int Variant::size()
 {
 	if (type == ARRAY)
-		return a->size();
+		return a->value.size();
 	else 
 		return 1;
 }
\ No newline at end of file
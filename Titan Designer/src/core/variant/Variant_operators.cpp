@@ -4,12 +4,6 @@
 #include "core/CoreNames.h"
 
 //Operators
-//Initialize
-void Variant::operator=(const Variant &r)
-{
-	reference(r);
-}
-
 //Comparison Evaluation
 bool Variant::eval_comp(const int EvalType, const Variant &right) const
 {
@@ -55,29 +49,29 @@ bool Variant::eval_comp(const int EvalType, const Variant &right) const
 	case STRING:
 		switch (EvalType)
 		{
-			case EQUAL: return *s == *right.s;
-			case NOTEQUAL: return *s != *right.s;
+			case EQUAL: return s->value == right.s->value;
+			case NOTEQUAL: return s->value != right.s->value;
 		}
 		break;
 	case VEC2:
 		switch (EvalType)
 		{
-			case EQUAL: return *v2 == *right.v2;
-			case NOTEQUAL: return *v2 != *right.v2;
+			case EQUAL: return v2 == right.v2;
+			case NOTEQUAL: return v2 != right.v2;
 		}
 		break;
 	case VEC3:
 		switch (EvalType)
 		{
-			case EQUAL: return *v3 == *right.v3;
-			case NOTEQUAL: return *v3 != *right.v3;
+			case EQUAL: return v3 == right.v3;
+			case NOTEQUAL: return v3 != right.v3;
 		}
 		break;
 	case VEC4:
 		switch (EvalType)
 		{
-			case EQUAL: return *v4 == *right.v4;
-			case NOTEQUAL: return *v4 != *right.v4;
+			case EQUAL: return v4 == right.v4;
+			case NOTEQUAL: return v4 != right.v4;
 		}
 		break;
 	case OBJECT:
@@ -149,9 +143,9 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 				case MULTIPLY:
-					return *right.v2 * to_float(i);
+					return right.v2 * to_float(i);
 				case DIVIDE:
-					return *right.v2 * to_float(i);
+					return right.v2 * to_float(i);
 				}
 				break;
 			}
@@ -178,22 +172,22 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 				case ADD:
-					return *right.v2 + f;
+					return right.v2 + f;
 				case SUBTRACT:
-					return *right.v2 - f;
+					return right.v2 - f;
 				case MULTIPLY:
-					return *right.v2 * f;
+					return right.v2 * f;
 				case DIVIDE:
-					return *right.v2 / f;
+					return right.v2 / f;
 				}
 				break;
 			}
 			break;
 		case STRING:
 			if (OPType == ADD)
-				return *s + *right.s;
+				return s->value + right.s->value;
 			else if (OPType == MULTIPLY)
-				return *s * right.i;
+				return s->value * right.i;
 			break;
 		case VEC2:
 			if (right.type == VEC2)
@@ -201,13 +195,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec2(*v2 + *right.v2);
+						return v2 + right.v2;
 					case SUBTRACT: 
-						return new vec2(*v2 - *right.v2);
+						return v2 - right.v2;
 					case MULTIPLY: 
-						return new vec2(*v2 * *right.v2);
+						return v2 * right.v2;
 					case DIVIDE: 
-						return new vec2(*v2 / *right.v2);
+						return v2 / right.v2;
 				}
 			}
 			else if (right.type == FLOAT)
@@ -215,13 +209,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec2(*v2 + right.f);
+						return v2 + right.f;
 					case SUBTRACT: 
-						return new vec2(*v2 - right.f);
+						return v2 - right.f;
 					case MULTIPLY: 
-						return new vec2(*v2 * right.f);
+						return v2 * right.f;
 					case DIVIDE: 
-						return new vec2(*v2 / right.f);
+						return v2 / right.f;
 				}
 			}
 			break;
@@ -231,13 +225,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec3(*v3 + *right.v3);
+						return v3 + right.v3;
 					case SUBTRACT: 
-						return new vec3(*v3 - *right.v3);
+						return v3 - right.v3;
 					case MULTIPLY: 
-						return new vec3(*v3 * *right.v3);
+						return v3 * right.v3;
 					case DIVIDE:
-						return new vec3(*v3 / *right.v3);
+						return v3 / right.v3;
 				}
 			}
 			else if (right.type == FLOAT)
@@ -245,13 +239,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec3(*v3 + right.f);
+						return v3 + right.f;
 					case SUBTRACT: 
-						return new vec3(*v3 - right.f);
+						return v3 - right.f;
 					case MULTIPLY: 
-						return new vec3(*v3 * right.f);
+						return v3 * right.f;
 					case DIVIDE: 
-						return new vec3(*v3 / right.f);
+						return v3 / right.f;
 				}
 			}		
 			break;
@@ -261,13 +255,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec4(*v4 + *right.v4);
+						return v4 + right.v4;
 					case SUBTRACT: 
-						return new vec4(*v4 - *right.v4);
+						return v4 - right.v4;
 					case MULTIPLY: 
-						return new vec4(*v4 * *right.v4);
+						return v4 * right.v4;
 					case DIVIDE: 
-						return new vec4(*v4 / *right.v4);
+						return v4 / right.v4;
 				}
 			}
 			else if (right.type == FLOAT)
@@ -275,13 +269,13 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new vec4(*v4 + right.f);
+						return v4 + right.f;
 					case SUBTRACT: 
-						return new vec4(*v4 - right.f);
+						return v4 - right.f;
 					case MULTIPLY: 
-						return new vec4(*v4 * right.f);
+						return v4 * right.f;
 					case DIVIDE: 
-						return new vec4(*v4 / right.f);
+						return v4 / right.f;
 				}
 			}
 			break;
@@ -291,11 +285,11 @@ Variant Variant::operate(const int OPType, const Variant &right) const
 				switch (OPType)
 				{
 					case ADD: 
-						return new mat4(*m4 + *right.m4);
+						return m4->value + right.m4->value;
 					case SUBTRACT: 
-						return new mat4(*m4 - *right.m4);
+						return m4->value - right.m4->value;
 					case MULTIPLY: 
-						return new mat4(*m4 * *right.m4);
+						return m4->value * right.m4->value;
 				}
 				break;
 			}
@@ -353,31 +347,31 @@ String Variant::ToString() const
 		break;
 
 	case STRING:
-		result = *s;
+		result = s->value;
 		break;
 
 	case VEC2:
-		result = v2->to_string();
+		result = v2.to_string();
 		break;
 
 	case VEC3:
-		result = v3->to_string();
+		result = v3.to_string();
 		break;
 
 	case VEC4:
-		result = v4->to_string();
+		result = v4.to_string();
 		break;
 
 	case MAT4:
-		result = m4->ToString();
+		result = m4->value.ToString();
 		break;
 
 	case COLOR:
-		result = c->toString();
+		result = c.toString();
 		break;
 
 	case TRANSFORM:
-		result = t->ToString();
+		result = t->value.ToString();
 		break;
 
 	case OBJECT:
@@ -386,23 +380,23 @@ String Variant::ToString() const
 		break;
 
 	case ARRAY:
-		if (a->size() == 0)
+		if (a->value.size() == 0)
 		{
 			result = "{ }";
 			break;
 		}
-		if (a->size() == 1)
+		if (a->value.size() == 1)
 		{
-			result = a->operator[] (0).ToString();
+			result = a->value[0].ToString();
 			break;
 		}
 
 		result = "{ ";
 
-		for (int c = 0; c < a->size() - 1; c++)
-			result += a->operator[](c).ToString() + ", ";
+		for (int c = 0; c < a->value.size() - 1; c++)
+			result += a->value[c].ToString() + ", ";
 
-		result += a->operator[](a->size() - 1).ToString() + " }";
+		result += a->value[a->value.size() - 1].ToString() + " }";
 		break;
 	default:
 		result = String("");
@@ -481,12 +475,12 @@ Variant::operator Real() const
 }
 Variant::operator String&() const
 {
-	return *s;
+	return s->value;
 }
 Variant::operator vec2&() const
 {
 	if (type == VEC2)
-		return *v2;
+		return const_cast<vec2&>(v2);
 
 	T_ERROR("Invalid Conversion");
 	return *new vec2();
@@ -494,7 +488,7 @@ Variant::operator vec2&() const
 Variant::operator vec3&() const
 {
 	if (type == VEC3)
-		return *v3;
+		return const_cast<vec3&>(v3);
 
 	T_ERROR("Invalid Conversion");
 	return *new vec3();
@@ -502,7 +496,7 @@ Variant::operator vec3&() const
 Variant::operator vec4&() const
 {
 	if (type == VEC4)
-		return *v4;
+		return const_cast<vec4&>(v4);
 
 	T_ERROR("Invalid Conversion");
 	return *new vec4();
@@ -510,7 +504,7 @@ Variant::operator vec4&() const
 Variant::operator mat4&() const
 {
 	if (type == MAT4)
-		return *m4;
+		return m4->value;
 
 	T_ERROR("Invalid Conversion");
 	return *new mat4();
@@ -518,7 +512,7 @@ Variant::operator mat4&() const
 Variant::operator Color&() const
 {
 	if (type == COLOR)
-		return *c;
+		return const_cast<Color&>(c);
 
 	T_ERROR("Invalid Conversion");
 	return *new Color;
@@ -526,7 +520,7 @@ Variant::operator Color&() const
 Variant::operator Transform&() const
 {
 	if (type == TRANSFORM)
-		return *t;
+		return t->value;
 
 	T_ERROR("Invalid Conversion");
 	return *new Transform;
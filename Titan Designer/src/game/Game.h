@@ -4,7 +4,6 @@
 #include "Time.h"
 #include "graphics/PostProcess.h"
 #include "graphics/Renderer.h"
-#include "Memory.h"
 #include "input/Input.h"
 
 #include "core/Window.h"
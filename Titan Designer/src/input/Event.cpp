@@ -1,16 +1,12 @@
 #include "Event.h"
 
-#include "EventManager.h"
-
 //Event
 Event::Event()
 {
-	EventManager::get_manager().register_event(this);
 }
 
 Event::~Event()
 {
-	EventManager::get_manager().clear_event(this);
 }
 
 String Event::get_name() const
@@ -11,19 +11,32 @@ EventManager::~EventManager()
 {
 }
 
-void EventManager::register_event(Event *e)
+InputEvent* EventManager::create_input_event(InputEvent::Type p_type)
 {
-	events.push_back(e);
+	return input_events.create(p_type);
 }
 
-void EventManager::clear_event(Event *e)
+UIEvent* EventManager::create_ui_event(UIEvent::Type p_type)
 {
-	events.clear(e);
+	return ui_events.create(p_type);
+}
+
+DropEvent* EventManager::create_drop_event(const String &p_filename)
+{
+	return drop_events.create(p_filename);
+}
+
+CollisionEvent* EventManager::create_collision_event()
+{
+	return collision_events.create();
 }
 
 void EventManager::clean()
 {
-	events.delete_all();
+	input_events.reset();
+	ui_events.reset();
+	drop_events.reset();
+	collision_events.reset();
 }
 
 void EventManager::init()
@@ -31,7 +44,13 @@ void EventManager::init()
 	default_manager = new EventManager;
 }
 
+void EventManager::free()
+{
+	delete default_manager;
+	default_manager = NULL;
+}
+
 EventManager& EventManager::get_manager()
 {
 	return *default_manager;
-}
\ No newline at end of file
+}
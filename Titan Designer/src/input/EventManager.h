@@ -1,24 +1,33 @@
 #pragma once
 
+#include "core/FramePool.h"
+
 #include "Event.h"
 
+//Owns the events of a frame, they are created in pools and reused after clean(). An
+//event must not be kept after the frame it was created in
 class EventManager
 {
 public:
 	EventManager();
 	~EventManager();
 
-	void register_event(Event *e);
-	void clear_event(Event *e);
+	InputEvent* create_input_event(InputEvent::Type p_type);
+	UIEvent* create_ui_event(UIEvent::Type p_type);
+	DropEvent* create_drop_event(const String &p_filename);
+	CollisionEvent* create_collision_event();
 
 	void clean();
 
 	static void init();
+	static void free();
 	static EventManager& get_manager();
 
 private:
 	static EventManager *default_manager;
 
-	Vector<Event> events;
+	FramePool<InputEvent> input_events;
+	FramePool<UIEvent> ui_events;
+	FramePool<DropEvent> drop_events;
+	FramePool<CollisionEvent> collision_events;
 };
-
@@ -3,6 +3,8 @@
 #include "core/Application.h"
 #include "core/WindowManager.h"
 
+#include "EventManager.h"
+
 Input *Input::singleton;
 
 Input::Input()
@@ -30,7 +32,7 @@ void Input::HandleEvent(const SDL_Event &event)
 		else if (event.type == SDL_FINGERUP)
 			pt = InputEvent::UP;
 
-		InputEvent *e = new InputEvent(InputEvent::FINGERPRESS);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::FINGERPRESS);
 		e->accept_finger_pos(size, button_pos);
 		e->press_type = pt;
 		e->index = (int)event.tfinger.fingerId;
@@ -39,7 +41,7 @@ void Input::HandleEvent(const SDL_Event &event)
 	}
 	else if (event.type == SDL_FINGERMOTION)
 	{
-		InputEvent *e = new InputEvent(InputEvent::FINGERMOVE);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::FINGERMOVE);
 		e->accept_finger_pos(size, button_pos);
 		e->index = (int)event.tfinger.fingerId;
 
@@ -54,7 +56,7 @@ void Input::HandleEvent(const SDL_Event &event)
 		else if (event.type == SDL_MOUSEBUTTONUP)
 			pt = InputEvent::UP;
 
-		InputEvent *e = new InputEvent(InputEvent::MOUSEPRESS);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::MOUSEPRESS);
 		e->accept_mouse_pos(size, button_pos);
 		e->button_type = MOUSE->get_ButtonType(event.button.button);
 		e->press_type = pt;
@@ -63,14 +65,14 @@ void Input::HandleEvent(const SDL_Event &event)
 	}
 	else if (event.type == SDL_MOUSEMOTION)
 	{
-		InputEvent *e = new InputEvent(InputEvent::MOUSEMOVE);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::MOUSEMOVE);
 		e->accept_mouse_pos(size, vec2(to_float(event.motion.x), to_float(event.motion.y)));
 
 		AddEvent(e);
 	}
 	else if (event.type == SDL_MOUSEWHEEL)
 	{
-		InputEvent *e = new InputEvent(InputEvent::MOUSE_SCROLL);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::MOUSE_SCROLL);
 		
 		if (event.wheel.x > 0)
 			e->scroll_type = Event::SCROLL_RIGHT;
@@ -95,7 +97,7 @@ void Input::HandleEvent(const SDL_Event &event)
 		else if (event.type == SDL_KEYUP)
 			pt = InputEvent::UP;
 
-		InputEvent *e = new InputEvent(InputEvent::KEYPRESS);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::KEYPRESS);
 		e->key = Key(event.key.keysym.sym);
 		e->mod = ModKey(event.key.keysym.mod);
 		e->press_type = pt;
@@ -105,7 +107,7 @@ void Input::HandleEvent(const SDL_Event &event)
 	}
 	else if (event.type == SDL_TEXTINPUT)
 	{
-		InputEvent *e = new InputEvent(InputEvent::TEXT_INPUT);
+		InputEvent *e = EventManager::get_manager().create_input_event(InputEvent::TEXT_INPUT);
 		e->key = Key(event.key.keysym.sym);
 		e->mod = ModKey(event.key.keysym.mod);
 		e->text = event.text.text;
@@ -113,7 +115,7 @@ void Input::HandleEvent(const SDL_Event &event)
 	}
 	else if (event.type == SDL_DROPFILE)
 	{
-		AddEvent(new DropEvent(event.drop.file));
+		AddEvent(EventManager::get_manager().create_drop_event(event.drop.file));
 	}
 }
 
@@ -122,9 +124,10 @@ void Input::AddEvent(Event *e)
 	events.push_back(e);
 }
 
+//the events themselves belong to the EventManager
 void Input::Clean()
 {
-	events.clean();
+	events.clear();
 }
 
 void Input::enable_text_input()
@@ -139,7 +142,7 @@ void Input::disable_text_input()
 
 void Input::Free()
 {
-	events.clean();
+	events.clear();
 }
 
 #undef CLASSNAME
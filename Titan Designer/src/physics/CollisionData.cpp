@@ -2,13 +2,14 @@
 
 #include "core/titanscript/ScriptComponent.h"
 #include "input/EventHandler.h"
+#include "input/EventManager.h"
 
 void CollisionData::BeginContact(b2Contact* contact)
 {
 	RigidBody2D* A = static_cast<RigidBody2D*>(contact->GetFixtureA()->GetBody()->GetUserData());
 	RigidBody2D* B = static_cast<RigidBody2D*>(contact->GetFixtureB()->GetBody()->GetUserData());
 
-	CollisionEvent *e = new CollisionEvent;
+	CollisionEvent *e = EventManager::get_manager().create_collision_event();
 	e->object = B;
 	e->contact = CollisionEvent::BEGIN;
 
@@ -20,7 +21,7 @@ void CollisionData::EndContact(b2Contact* contact)
 	RigidBody2D* A = static_cast<RigidBody2D*>(contact->GetFixtureA()->GetBody()->GetUserData());
 	RigidBody2D* B = static_cast<RigidBody2D*>(contact->GetFixtureB()->GetBody()->GetUserData());
 
-	CollisionEvent *e = new CollisionEvent;
+	CollisionEvent *e = EventManager::get_manager().create_collision_event();
 	e->object = B;
 	e->contact = CollisionEvent::END;
 
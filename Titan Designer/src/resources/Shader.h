@@ -82,7 +82,7 @@ private:
 
 	bool isvalid = false;
 
-    Dictionary<String, Uniform> uniforms;
+    HashMap<String, Uniform> uniforms;
 	Dictionary<String, Block> blocks;
 
 	File vertex_path;
@@ -0,0 +1,73 @@
+#include "Test.h"
+
+#include "core/Dictionary.h"
+#include "types/Callable.h"
+
+//how a call took its arguments before and after
+static int by_value(Array<Variant> p_args)
+{
+	return p_args.size() + (p_args[0] == p_args[1] ? 1 : 0);
+}
+
+static int by_view(const Arguments &p_args)
+{
+	return p_args.size() + (p_args[0] == p_args[1] ? 1 : 0);
+}
+
+//runs p_function once and logs the operator new calls it made, 0 unless TESTS is set
+template <typename F>
+static void log_allocations(const String &p_name, F p_function)
+{
+	unsigned long long before = TestRunner::get_allocation_count();
+	p_function();
+
+	T_LOG(p_name + ": " + String(int(TestRunner::get_allocation_count() - before)) + " allocations");
+}
+
+BENCHMARK(argument_views)
+{
+	const int calls = 1000;
+	volatile int sink = 0;
+
+	Array<Variant> args;
+	args.push_back(Variant(String("first argument of the call")));
+	args.push_back(Variant(String("second argument of the call")));
+	args.push_back(Variant(1));
+	args.push_back(Variant(2.0f));
+
+	auto values = [&]() { for (int c = 0; c < calls; c++) sink = sink + by_value(args); };
+	auto views = [&]() { for (int c = 0; c < calls; c++) sink = sink + by_view(args); };
+
+	TestRunner::measure("Array<Variant> by value, 1000 calls", 100, values);
+	TestRunner::measure("Arguments view, 1000 calls", 100, views);
+
+	log_allocations("Array<Variant> by value, 1000 calls", values);
+	log_allocations("Arguments view, 1000 calls", views);
+}
+
+//contains compares the values in place instead of copying each one
+BENCHMARK(container_contains)
+{
+	const int count = 100;
+	volatile int sink = 0;
+
+	Array<String> array;
+	Dictionary<int, String> dictionary;
+
+	for (int c = 0; c < count; c++)
+	{
+		array.push_back("a string value that does not fit in place " + String(c));
+		dictionary[c] = array[c];
+	}
+
+	String missing = "a string value that is not in the containers";
+
+	auto in_array = [&]() { sink = sink + (array.contains(missing) ? 1 : 0); };
+	auto in_dictionary = [&]() { sink = sink + (dictionary.contains(missing) ? 1 : 0); };
+
+	TestRunner::measure("Array<String>::contains, 100 values", 10000, in_array);
+	TestRunner::measure("Dictionary<int, String>::contains, 100 values", 10000, in_dictionary);
+
+	log_allocations("Array<String>::contains, 100 values", in_array);
+	log_allocations("Dictionary<int, String>::contains, 100 values", in_dictionary);
+}
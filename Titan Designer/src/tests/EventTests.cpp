@@ -0,0 +1,40 @@
+#include "Test.h"
+
+#include "SDL.h"
+
+#include "input/Input.h"
+#include "input/EventManager.h"
+
+//replays mouse motion through Input frame by frame, like Application::Loop
+static void replay_mouse_motion(int p_frames, int p_events_per_frame)
+{
+	for (int frame = 0; frame < p_frames; frame++)
+	{
+		for (int c = 0; c < p_events_per_frame; c++)
+		{
+			SDL_Event event;
+			event.type = SDL_MOUSEMOTION;
+			event.motion.x = c;
+			event.motion.y = frame;
+
+			INPUT->HandleEvent(event);
+		}
+
+		INPUT->Clean();
+		EventManager::get_manager().clean();
+	}
+}
+
+TEST(events_do_not_allocate)
+{
+	const int frames = 1000;
+	const int events_per_frame = 100;
+
+	//the pools and the list of Input grow in the first frame
+	replay_mouse_motion(2, events_per_frame);
+
+	unsigned long long before = TestRunner::get_allocation_count();
+	replay_mouse_motion(frames, events_per_frame);
+
+	CHECK(TestRunner::get_allocation_count() - before == 0);
+}
@@ -0,0 +1,62 @@
+#include "Test.h"
+
+#include "core/Dictionary.h"
+#include "core/HashMap.h"
+
+//looks up every key of p_keys p_rounds times, p_map is a HashMap or a Dictionary
+template<class M, class KEY>
+static int lookup_all(M &p_map, const Array<KEY> &p_keys, int p_rounds)
+{
+	int found = 0;
+
+	for (int r = 0; r < p_rounds; r++)
+		for (const KEY &key : p_keys)
+			found += p_map.contains(key) ? 1 : 0;
+
+	return found;
+}
+
+//fills a HashMap and a Dictionary with p_keys and measures the lookups in both
+template<class KEY>
+static void compare_lookups(const String &p_name, const Array<KEY> &p_keys)
+{
+	const int rounds = 100;
+	volatile int sink = 0;
+
+	HashMap<KEY, size_t> hash_map;
+	Dictionary<KEY, size_t> dictionary;
+
+	for (int c = 0; c < p_keys.size(); c++)
+	{
+		hash_map[p_keys[c]] = c;
+		dictionary[p_keys[c]] = c;
+	}
+
+	String count = String(p_keys.size() * rounds) + " lookups";
+
+	TestRunner::measure("HashMap, " + p_name + ", " + count, 100, [&]() { sink = sink + lookup_all(hash_map, p_keys, rounds); });
+	TestRunner::measure("Dictionary, " + p_name + ", " + count, 100, [&]() { sink = sink + lookup_all(dictionary, p_keys, rounds); });
+}
+
+//the key distributions of the tables that moved to HashMap
+BENCHMARK(hashmap_lookup)
+{
+	//State::vars and State::funcs, a few dozen script names
+	Array<StringName> names;
+	for (int c = 0; c < 48; c++)
+		names.push_back(StringName("script_var_" + String(c)));
+
+	//Shader::uniforms, a handful of uniform names
+	Array<String> uniforms;
+	for (int c = 0; c < 16; c++)
+		uniforms.push_back("uniforms.material_" + String(c));
+
+	//TypeManager::type_ids, a few hundred consecutive ids
+	Array<int> type_ids;
+	for (int c = 0; c < 400; c++)
+		type_ids.push_back(c);
+
+	compare_lookups("48 StringName keys", names);
+	compare_lookups("16 String keys", uniforms);
+	compare_lookups("400 int keys", type_ids);
+}
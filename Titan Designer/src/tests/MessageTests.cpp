@@ -0,0 +1,30 @@
+#include "Test.h"
+
+#include <thread>
+
+//logs p_count copies of the same message, the writer only counts repeats so it keeps up
+static void log_messages(int p_count)
+{
+	for (int c = 0; c < p_count; c++)
+		T_INFO("message queue benchmark");
+}
+
+//the time a thread spends logging, the console and the file are written by the writer thread
+BENCHMARK(message_queue)
+{
+	const int messages = 1000;
+	const int threads = 4;
+
+	TestRunner::measure("T_INFO from one thread, 1000 messages", 100, [&]() { log_messages(messages); });
+
+	TestRunner::measure("T_INFO from 4 threads, 4000 messages", 100, [&]()
+	{
+		std::thread workers[threads];
+
+		for (std::thread &worker : workers)
+			worker = std::thread(log_messages, messages);
+
+		for (std::thread &worker : workers)
+			worker.join();
+	});
+}
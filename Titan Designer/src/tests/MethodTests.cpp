@@ -0,0 +1,67 @@
+#include "Test.h"
+
+#include "types/MethodMaster.h"
+#include "ui/LabelButton.h"
+
+//a MemberTable next to the linear scan by name it replaced
+BENCHMARK(member_table_lookup)
+{
+	const int members = 64;
+	const int rounds = 100;
+	volatile int sink = 0;
+
+	Array<StringName> names;
+	Array<int> values;
+	MemberTable<int> table;
+
+	for (int c = 0; c < members; c++)
+	{
+		names.push_back(StringName("member_" + String(c)));
+		values.push_back(c);
+	}
+
+	for (int c = 0; c < members; c++)
+		table.add(names[c], &values[c]);
+
+	TestRunner::measure("MemberTable, 64 members, 6400 lookups", 100, [&]()
+	{
+		for (int r = 0; r < rounds; r++)
+			for (const StringName &name : names)
+				sink = sink + *table.get(name);
+	});
+
+	TestRunner::measure("linear scan, 64 members, 6400 lookups", 100, [&]()
+	{
+		for (int r = 0; r < rounds; r++)
+			for (const StringName &name : names)
+				for (int c = 0; c < members; c++)
+					if (names[c] == name)
+					{
+						sink = sink + values[c];
+						break;
+					}
+	});
+}
+
+//members of Node looked up on LabelButton, which chains through Button and Control
+BENCHMARK(inherited_member_lookup)
+{
+	const int lookups = 1000;
+	volatile int sink = 0;
+
+	VariantType type = LabelButton::get_type_name_static();
+	StringName method = "get_child";
+	StringName property = "name";
+
+	TestRunner::measure("MethodMaster::get_method, inherited, 1000 lookups", 100, [&]()
+	{
+		for (int c = 0; c < lookups; c++)
+			sink = sink + (MMASTER->get_method(type, method) ? 1 : 0);
+	});
+
+	TestRunner::measure("MethodMaster::get_property, inherited, 1000 lookups", 100, [&]()
+	{
+		for (int c = 0; c < lookups; c++)
+			sink = sink + (MMASTER->get_property(type, property) ? 1 : 0);
+	});
+}
@@ -0,0 +1,193 @@
+#include "Test.h"
+
+#include <fstream>
+
+#include "core/ContentManager.h"
+#include "core/titanscript/TitanScript.h"
+#include "world/World.h"
+
+//writes p_source to a script in the assets directory and loads it
+static TitanScript* load_script(const String &p_name, const String &p_source)
+{
+	File file = File(p_name);
+
+	std::ofstream stream(file.get_absolute_path().c_str());
+	stream << p_source.c_str();
+	stream.close();
+
+	return new TitanScript(file.get_absolute_path());
+}
+
+static World* make_update_world(TitanScript *p_prototype, int p_count, Array<WorldObject*> &r_objects)
+{
+	World *world = new World;
+
+	for (int c = 0; c < p_count; c++)
+	{
+		WorldObject *object = new WorldObject;
+		object->set_pos(vec3(float(c), 0.0f, 0.0f));
+		object->set_script(c == 0 ? p_prototype : p_prototype->CreateNewInstance());
+
+		world->add_child(object);
+		r_objects.push_back(object);
+	}
+
+	return world;
+}
+
+TEST(parallel_update_matches_serial)
+{
+	const int count = 64;
+	const String source =
+		"extends WorldObject\n"
+		"func update()\n"
+		"	pos = pos * 2.0 + vec3(1.0, 2.0, 3.0)\n";
+
+	TitanScript *serial_script = load_script("Scripts/parallel_update_test.ts", source);
+	TitanScript *parallel_script = load_script("Scripts/parallel_update_test.ts", source);
+	serial_script->set_local_update(true);
+	parallel_script->set_local_update(true);
+
+	Array<WorldObject*> serial_objects, parallel_objects;
+	World *serial = make_update_world(serial_script, count, serial_objects);
+	World *parallel = make_update_world(parallel_script, count, parallel_objects);
+	parallel->set_parallel_update(true);
+
+	for (int c = 0; c < 3; c++)
+	{
+		serial->update();
+		parallel->update();
+	}
+
+	for (int c = 0; c < count; c++)
+		CHECK(parallel_objects[c]->get_pos() == serial_objects[c]->get_pos());
+}
+
+TEST(instance_outlives_prototype)
+{
+	TitanScript *prototype = load_script("Scripts/instance_test.ts",
+		"extends WorldObject\n"
+		"func update()\n"
+		"	pos = vec3(1.0, 2.0, 3.0)\n");
+
+	TitanScript *instance = prototype->CreateNewInstance();
+	prototype->Clean();
+
+	WorldObject *object = new WorldObject;
+	object->set_script(instance);
+	instance->RunFunction("update");
+
+	CHECK(object->get_pos() == vec3(1.0f, 2.0f, 3.0f));
+
+	instance->Clean();
+}
+
+TEST(bytecode_matches_tree)
+{
+	const String source =
+		"extends WorldObject\n"
+		"func arithmetic()\n"
+		"	return (3 + 4) * 2 - 10 / 4\n"
+		"func loops()\n"
+		"	total = 0\n"
+		"	for i = 0, i < 10, i++\n"
+		"		total += i * i\n"
+		"	n = 0\n"
+		"	while n < 5\n"
+		"		n++\n"
+		"	return total + n\n"
+		"func branch(x)\n"
+		"	if x > 3\n"
+		"		return 1\n"
+		"	elseif x > 1\n"
+		"		return 2\n"
+		"	else\n"
+		"		return 3\n"
+		"func calls()\n"
+		"	return branch(5) * 100 + branch(2) * 10 + branch(0)\n"
+		"func vectors()\n"
+		"	v = vec3(1.0, 2.0, 3.0) * 2.0 + vec3(0.5, 0.5, 0.5)\n"
+		"	return v.x + v.y + v.z\n"
+		"func members()\n"
+		"	pos = vec3(4.0, 5.0, 6.0)\n"
+		"	pos.y += 1.0\n"
+		"	return pos.y\n"
+		"func strings()\n"
+		"	return \"a\" + \"b\"\n";
+
+	TitanScript *tree = load_script("Scripts/bytecode_test.ts", source);
+	TitanScript *bytecode = load_script("Scripts/bytecode_test.ts", source);
+	tree->set_execution_mode(TitanScript::EXECUTE_TREE);
+	bytecode->set_execution_mode(TitanScript::EXECUTE_BYTECODE);
+
+	WorldObject *tree_object = new WorldObject;
+	WorldObject *bytecode_object = new WorldObject;
+	tree_object->set_script(tree);
+	bytecode_object->set_script(bytecode);
+
+	const char *functions[] = { "arithmetic", "loops", "calls", "vectors", "members", "strings" };
+
+	for (const char *function : functions)
+	{
+		Variant expected = tree->RunFunction(function);
+		Variant result = bytecode->RunFunction(function);
+
+		CHECK(result == expected);
+	}
+
+	CHECK(bytecode_object->get_pos() == tree_object->get_pos());
+}
+
+//pos.x += 1.0 evaluates pos once, pos.x = pos.x + 1.0 is what it compiled to before
+BENCHMARK(modify_member)
+{
+	TitanScript *script = load_script("Scripts/modify_benchmark.ts",
+		"extends WorldObject\n"
+		"func modify()\n"
+		"	for i = 0, i < 1000, i++\n"
+		"		pos.x += 1.0\n"
+		"func assign()\n"
+		"	for i = 0, i < 1000, i++\n"
+		"		pos.x = pos.x + 1.0\n");
+
+	WorldObject *object = new WorldObject;
+	object->set_script(script);
+
+	TestRunner::measure("pos.x += 1.0, 1000 times", 1000, [&]() { script->RunFunction("modify"); });
+	TestRunner::measure("pos.x = pos.x + 1.0, 1000 times", 1000, [&]() { script->RunFunction("assign"); });
+}
+
+//a 5000 line script of 1000 functions, p_variant changes the body of the one in the middle
+static String make_large_source(int p_variant)
+{
+	String source = "extends WorldObject\n";
+
+	for (int c = 0; c < 1000; c++)
+	{
+		source += "func function_" + String(c) + "(x)\n";
+		source += "	y = x * 2\n";
+		source += "	if y > 10\n";
+		source += "		return y - " + String(c == 500 ? p_variant : c) + "\n";
+		source += "	return y + " + String(c) + "\n";
+	}
+
+	return source;
+}
+
+//an edit to one function of a large script, reloaded and parsed from scratch
+BENCHMARK(reload_large_script)
+{
+	String sources[] = { make_large_source(0), make_large_source(1) };
+	TitanScript *script = load_script("Scripts/reload_benchmark.ts", sources[0]);
+	int edits = 0;
+
+	TestRunner::measure("reload after a one line edit, 5000 lines", 20, [&]() { script->reload(sources[++edits % 2]); });
+
+	TestRunner::measure("full parse, 5000 lines", 20, [&]()
+	{
+		TitanScript *parsed = load_script("Scripts/reload_benchmark.ts", sources[++edits % 2]);
+		parsed->Clean();
+	});
+
+	script->Clean();
+}
@@ -0,0 +1,30 @@
+#include "Test.h"
+
+#include "core/Node.h"
+#include "types/Method.h"
+
+//1000 deferred emissions and the flush at the end of the frame, next to emitting directly
+BENCHMARK(deferred_signals)
+{
+	const int emissions = 1000;
+	int received = 0;
+
+	Node *node = new Node;
+	node->connect("children_changed", Connection::create_from_lambda(new V_Method_0([&]() { received++; })));
+
+	TestRunner::measure("emit_signal_deferred and flush, 1000 signals", 100, [&]()
+	{
+		for (int c = 0; c < emissions; c++)
+			node->emit_signal_deferred("children_changed");
+
+		Scriptable::flush_deferred_signals();
+	});
+
+	TestRunner::measure("emit_signal, 1000 signals", 100, [&]()
+	{
+		for (int c = 0; c < emissions; c++)
+			node->emit_signal("children_changed");
+	});
+
+	delete node;
+}
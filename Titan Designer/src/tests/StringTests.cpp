@@ -0,0 +1,71 @@
+#include "Test.h"
+
+#include <thread>
+
+//p_count names with p_prefix, as Strings so building them is not measured
+static Array<String> make_names(const String &p_prefix, int p_count)
+{
+	Array<String> names;
+
+	for (int c = 0; c < p_count; c++)
+		names.push_back(p_prefix + String(c));
+
+	return names;
+}
+
+static void intern_all(const Array<String> *p_names)
+{
+	for (const String &name : *p_names)
+		StringName interned = name;
+}
+
+BENCHMARK(stringname_intern)
+{
+	const int threads = 4;
+
+	Array<String> names = make_names("interned_name_", 1000);
+	intern_all(&names);
+
+	TestRunner::measure("StringName of an existing name, 1000 names", 100, [&]() { intern_all(&names); });
+
+	//entries are never removed, every run adds its own names once
+	int run = 0;
+	Array<String> new_names[10];
+	for (int c = 0; c < 10; c++)
+		new_names[c] = make_names("new_name_" + String(c) + "_", 1000);
+
+	TestRunner::measure("StringName of a new name, 1000 names", 10, [&]() { intern_all(&new_names[run++]); });
+
+	TestRunner::measure("StringName of an existing name from 4 threads, 4000 names", 100, [&]()
+	{
+		std::thread workers[threads];
+
+		for (std::thread &worker : workers)
+			worker = std::thread(intern_all, &names);
+
+		for (std::thread &worker : workers)
+			worker.join();
+	});
+}
+
+//a StringName compares its entries, a String its characters
+BENCHMARK(stringname_compare)
+{
+	const int compares = 1000;
+	volatile int sink = 0;
+
+	String a = "a_longer_member_name_left", b = "a_longer_member_name_right";
+	StringName name_a = a, name_b = b;
+
+	TestRunner::measure("StringName ==, 1000 compares", 1000, [&]()
+	{
+		for (int c = 0; c < compares; c++)
+			sink = sink + (name_a == name_b ? 1 : 0);
+	});
+
+	TestRunner::measure("String ==, 1000 compares", 1000, [&]()
+	{
+		for (int c = 0; c < compares; c++)
+			sink = sink + (a == b ? 1 : 0);
+	});
+}
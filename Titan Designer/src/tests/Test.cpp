@@ -0,0 +1,101 @@
+#include "Test.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+int TestRunner::failures = 0;
+
+#if TESTS
+
+static std::atomic<unsigned long long> allocations(0);
+
+void* operator new(std::size_t p_size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void *p = std::malloc(p_size ? p_size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p_pointer) noexcept
+{
+	std::free(p_pointer);
+}
+
+unsigned long long TestRunner::get_allocation_count()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+unsigned long long TestRunner::get_allocation_count()
+{
+	return 0;
+}
+
+#endif
+
+//function statics, the TEST registrations run before main in any order
+Array<TestRunner::Entry>& TestRunner::get_tests()
+{
+	static Array<Entry> tests;
+	return tests;
+}
+
+Array<TestRunner::Entry>& TestRunner::get_benchmarks()
+{
+	static Array<Entry> benchmarks;
+	return benchmarks;
+}
+
+bool TestRunner::add_test(const char *p_name, TestFunction p_function)
+{
+	Entry entry = { p_name, p_function };
+	get_tests().push_back(entry);
+	return true;
+}
+
+bool TestRunner::add_benchmark(const char *p_name, TestFunction p_function)
+{
+	Entry entry = { p_name, p_function };
+	get_benchmarks().push_back(entry);
+	return true;
+}
+
+void TestRunner::check(bool p_condition, const char *p_expression, const char *p_file, int p_line)
+{
+	if (p_condition)
+		return;
+
+	failures++;
+	MessageHandler::log(TMessage::T_ERROR, String("Check failed: ") + p_expression, p_file, p_line);
+}
+
+int TestRunner::run_all()
+{
+	failures = 0;
+
+	for (const Entry &entry : get_tests())
+	{
+		int before = failures;
+		entry.function();
+
+		T_LOG(String(entry.name) + (failures == before ? ": passed" : ": FAILED"));
+	}
+
+	T_LOG(String(get_tests().size()) + " tests, " + String(failures) + " failed checks");
+	return failures;
+}
+
+void TestRunner::run_benchmarks()
+{
+	for (const Entry &entry : get_benchmarks())
+	{
+		T_LOG(String("Benchmark ") + entry.name);
+		entry.function();
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+
+#include "core/Array.h"
+#include "core/String.h"
+#include "core/TMessage.h"
+
+//builds the TestApp instead of the editor or the game
+#define TESTS 0
+
+#define TEST(NAME) \
+	static void test_##NAME(); \
+	static bool test_##NAME##_added = TestRunner::add_test(#NAME, test_##NAME); \
+	static void test_##NAME()
+
+#define BENCHMARK(NAME) \
+	static void benchmark_##NAME(); \
+	static bool benchmark_##NAME##_added = TestRunner::add_benchmark(#NAME, benchmark_##NAME); \
+	static void benchmark_##NAME()
+
+#define CHECK(X) TestRunner::check((X), #X, __FILE__, __LINE__)
+
+//Runs the functions registered with TEST and BENCHMARK, failed checks are logged as errors.
+class TestRunner
+{
+public:
+	typedef void(*TestFunction)();
+
+	static bool add_test(const char *p_name, TestFunction p_function);
+	static bool add_benchmark(const char *p_name, TestFunction p_function);
+
+	static void check(bool p_condition, const char *p_expression, const char *p_file, int p_line);
+
+	//returns the number of failed checks
+	static int run_all();
+	static void run_benchmarks();
+
+	//operator new calls since the start, counted only when TESTS is set
+	static unsigned long long get_allocation_count();
+
+	//logs the time per iteration of p_function
+	template <typename F>
+	static void measure(const String &p_name, int p_iterations, F p_function)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		for (int c = 0; c < p_iterations; c++)
+			p_function();
+
+		auto end = std::chrono::high_resolution_clock::now();
+		long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+		T_LOG(p_name + ": " + String(float(ns) / float(p_iterations)) + " ns");
+	}
+
+private:
+	struct Entry
+	{
+		const char *name;
+		TestFunction function;
+	};
+
+	static Array<Entry>& get_tests();
+	static Array<Entry>& get_benchmarks();
+
+	static int failures;
+};
@@ -0,0 +1,36 @@
+#include "TestApp.h"
+
+#include "SDL.h"
+
+#include "Test.h"
+#include "graphics/View.h"
+#include "graphics/Renderer.h"
+
+void TestApp::init()
+{
+	//worlds look up the active viewport
+	Renderer* r = new ForwardRenderer;
+	Viewport *v = new Viewport(r);
+	VIEW->set_default_viewport(v);
+	VIEW->set_active_viewport(v);
+}
+
+//the tests run in the first frame, once the engine and the view are initialized
+void TestApp::update()
+{
+	if (finished)
+		return;
+
+	finished = true;
+	failures = TestRunner::run_all();
+	TestRunner::run_benchmarks();
+
+	SDL_Event quit;
+	quit.type = SDL_QUIT;
+	SDL_PushEvent(&quit);
+}
+
+int TestApp::get_failures() const
+{
+	return failures;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/Application.h"
+
+//Runs the tests and benchmarks in the first frame and quits.
+class TestApp : public Application
+{
+	OBJ_DEFINITION(TestApp, Application);
+
+public:
+	TestApp(Platform *t) : Application(t) { failures = 0; finished = false; }
+
+	void init() override;
+	void update() override;
+
+	int get_failures() const;
+
+private:
+	int failures;
+	bool finished;
+};
@@ -5,8 +5,10 @@
 #include "core/variant/Variant.h"
 #include "core/variant/VariantType.h"
 #include "core/Array.h"
+#include "core/ArrayView.h"
 
-typedef Array<Variant> Arguments;
+//the arguments of a call, a view of values owned by the caller
+typedef ArrayView<Variant> Arguments;
 
 struct Parameter
 {
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <type_traits>
+
+struct Method;
+class Event;
+
+//Callbacks the engine runs on objects every frame or on every event. They are looked up
+//once per type and once per script, so objects that do nothing for one can be skipped
+enum Lifecycle
+{
+	LIFECYCLE_READY,
+	LIFECYCLE_UPDATE,
+	LIFECYCLE_DRAW,
+	LIFECYCLE_HANDLE_EVENT,
+	LIFECYCLE_COUNT
+};
+
+struct LifecycleTable
+{
+	LifecycleTable()
+	{
+		for (int c = 0; c < LIFECYCLE_COUNT; c++)
+		{
+			methods[c] = NULL;
+			native[c] = false;
+		}
+	}
+
+	//bound method with the name of the callback, Scriptable::run_callback calls it when the script does not
+	Method *methods[LIFECYCLE_COUNT];
+
+	//a class of the type overrides the empty default of the callback
+	bool native[LIFECYCLE_COUNT];
+};
+
+template<typename...> struct LifecycleVoid { typedef void type; };
+
+//whether T declares the callback itself instead of only inheriting it. When the name is
+//overloaded the type of &T::NAME is unknown, T counts as declaring it when it has one
+#define DECLARES_CALLBACK(NAME, ...)\
+template<typename T, typename = void> struct Has_##NAME : std::false_type { };\
+template<typename T> struct Has_##NAME<T, typename LifecycleVoid<decltype(static_cast<void (T::*)(__VA_ARGS__)>(&T::NAME))>::type> : std::true_type { };\
+template<typename T, typename = void> struct Declares_##NAME : Has_##NAME<T> { };\
+template<typename T> struct Declares_##NAME<T, typename LifecycleVoid<decltype(&T::NAME)>::type> : std::is_same<decltype(&T::NAME), void (T::*)(__VA_ARGS__)> { };
+
+DECLARES_CALLBACK(ready)
+DECLARES_CALLBACK(update)
+DECLARES_CALLBACK(draw)
+DECLARES_CALLBACK(handle_event, Event*)
+
+#undef DECLARES_CALLBACK
+
+//one bit per Lifecycle callback that T declares
+template<typename T>
+unsigned get_declared_callbacks()
+{
+	return (Declares_ready<T>::value ? 1u << LIFECYCLE_READY : 0) |
+		(Declares_update<T>::value ? 1u << LIFECYCLE_UPDATE : 0) |
+		(Declares_draw<T>::value ? 1u << LIFECYCLE_DRAW : 0) |
+		(Declares_handle_event<T>::value ? 1u << LIFECYCLE_HANDLE_EVENT : 0);
+}
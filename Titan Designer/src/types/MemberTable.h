@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/Array.h"
+#include "core/String.h"
+
+//Members of one type by name, an open addressing table probed by the StringName hash.
+//Members are added while the types are registered, lookups never allocate. The values
+//are also kept in the order they were added, for listing them.
+template<typename T>
+class MemberTable
+{
+public:
+	T* get(const StringName &p_name) const
+	{
+		if (slots.size() == 0)
+			return NULL;
+
+		size_t mask = slots.size() - 1;
+
+		for (size_t c = p_name.get_hash() & mask;; c = (c + 1) & mask)
+		{
+			const Slot &slot = slots[static_cast<int>(c)];
+
+			if (!slot.value)
+				return NULL;
+
+			if (slot.name == p_name)
+				return slot.value;
+		}
+	}
+
+	bool contains(const StringName &p_name) const
+	{
+		return get(p_name) != NULL;
+	}
+
+	//returns false when a member with this name exists already, the first one is kept
+	bool add(const StringName &p_name, T *p_value)
+	{
+		if (contains(p_name))
+			return false;
+
+		//at most half of the slots are used, so probes stay short
+		if ((values.size() + 1) * 2 > slots.size())
+			grow();
+
+		insert(p_name, p_value);
+		values.push_back(p_value);
+		return true;
+	}
+
+	const Array<T*>& get_values() const
+	{
+		return values;
+	}
+
+	int size() const
+	{
+		return values.size();
+	}
+
+private:
+	struct Slot
+	{
+		StringName name;
+		T *value = NULL;
+	};
+
+	void grow()
+	{
+		Array<Slot> old = slots;
+
+		slots.clear();
+		slots.resize(old.size() ? old.size() * 2 : 8);
+
+		for (int c = 0; c < old.size(); c++)
+			if (old[c].value)
+				insert(old[c].name, old[c].value);
+	}
+
+	void insert(const StringName &p_name, T *p_value)
+	{
+		size_t mask = slots.size() - 1;
+		size_t c = p_name.get_hash() & mask;
+
+		while (slots[static_cast<int>(c)].value)
+			c = (c + 1) & mask;
+
+		slots[static_cast<int>(c)].name = p_name;
+		slots[static_cast<int>(c)].value = p_value;
+	}
+
+	Array<Slot> slots;
+	Array<T*> values;
+};
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <string>
 #include <sstream>
+#include <cstring>
 
 #include "core/variant/Variant.h"
 #include "Callable.h"
@@ -18,16 +19,56 @@
 #define INVOKE0(METHOD) return CAST()(in.operator Object*())->METHOD()
 #define INVOKE(METHOD, ARGS) return CAST()(in.operator Object*())->METHOD(ARGS)
 
+struct Method;
+
+//most arguments a native method takes, including the object
+#define MAX_METHOD_ARGS 4
+
+//Direct entry point of a Method. p_args holds arg_count Variants, the object first
+//for member methods, and the return value is written into r_result.
+typedef void(*MethodThunk)(Method *p_method, const Variant *p_args, Variant &r_result);
+
+//member function pointer stored without its type, the thunk casts it back
+struct MethodTarget
+{
+	template<typename F>
+	void set(F p_function)
+	{
+		static_assert(sizeof(F) <= sizeof(data), "member function pointer does not fit");
+		memcpy(data, &p_function, sizeof(F));
+	}
+
+	template<typename F>
+	F get() const
+	{
+		F function;
+		memcpy(&function, data, sizeof(F));
+		return function;
+	}
+
+	char data[4 * sizeof(void*)];
+};
+
 //base classes for method
 struct Method : Callable
 {
-	Method() { }
+	Method() { thunk = call_operator; }
+
+	virtual Variant operator()(const Arguments &args) { return Variant(); }
 
-	virtual Variant operator()(const Array<Variant> &args) { return Variant(); }
+	void call(const Variant *p_args, Variant &r_result) { thunk(this, p_args, r_result); }
+
+	static void call_operator(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		r_result = p_method->operator()(Arguments(p_args, p_method->arg_count));
+	}
+
+	MethodThunk thunk;
+	MethodTarget target;
 
 	StringName name = "";
 	bool returns_variant;
-	bool is_const;
+	bool is_const = false;
 	int arg_count;
 	ParameterNames param_names;
 	ParameterTypes param_types;
@@ -78,92 +119,112 @@ struct ReturnMethod : public Method
 
 struct V_Method_0 : public VoidMethod
 {
-	V_Method_0() { arg_count = 0; }
+	V_Method_0() { arg_count = 0; thunk = call_functor; }
 	V_Method_0(std::function<void()> p_func) : V_Method_0() { func = p_func; }
-    void operator()() { func(); }
-    Variant invoke_return() { func(); return Variant(); }
-    std::function<void()> func;
+	void operator()() { Variant result; call(NULL, result); }
+	Variant invoke_return() { operator()(); return Variant(); }
+	std::function<void()> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { static_cast<V_Method_0*>(p_method)->func(); }
 };
 
 struct V_Method_1 : public VoidMethod
 {
-	V_Method_1() { arg_count = 1; }
+	V_Method_1() { arg_count = 1; thunk = call_functor; }
 	V_Method_1(std::function<void(VAR)> p_func) : V_Method_1() { func = p_func; }
-	void operator()(VAR arg_0) { func(arg_0); }
-	Variant invoke_return(VAR arg_0) { func(arg_0); return Variant(); }
+	void operator()(VAR arg_0) { Variant result; call(&arg_0, result); }
+	Variant invoke_return(VAR arg_0) { operator()(arg_0); return Variant(); }
 	std::function<void(VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { static_cast<V_Method_1*>(p_method)->func(p_args[0]); }
 };
 
 struct V_Method_2 : public VoidMethod
 {
-	V_Method_2() { arg_count = 2; }
+	V_Method_2() { arg_count = 2; thunk = call_functor; }
 	V_Method_2(std::function<void(VAR, VAR)> p_func) : V_Method_2() { func = p_func; }
-	void operator()(VAR arg_0, VAR arg_1) { func(arg_0, arg_1); }
-	Variant invoke_return(VAR arg_0, VAR arg_1) { func(arg_0, arg_1); return Variant(); }
+	void operator()(VAR arg_0, VAR arg_1) { Variant args[2] = { arg_0, arg_1 }; Variant result; call(args, result); }
+	Variant invoke_return(VAR arg_0, VAR arg_1) { operator()(arg_0, arg_1); return Variant(); }
 	std::function<void(VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { static_cast<V_Method_2*>(p_method)->func(p_args[0], p_args[1]); }
 };
 
 struct V_Method_3 : public VoidMethod
 {
-	V_Method_3() { arg_count = 3; }
+	V_Method_3() { arg_count = 3; thunk = call_functor; }
 	V_Method_3(std::function<void(VAR, VAR, VAR)> p_func) : V_Method_3() { func = p_func; }
-	void operator()(VAR arg_0, VAR arg_1, VAR arg_2) { func(arg_0, arg_1, arg_2); }
-	Variant invoke_return(VAR arg_0, VAR arg_1, VAR arg_2) { func(arg_0, arg_1, arg_2); return Variant(); }
+	void operator()(VAR arg_0, VAR arg_1, VAR arg_2) { Variant args[3] = { arg_0, arg_1, arg_2 }; Variant result; call(args, result); }
+	Variant invoke_return(VAR arg_0, VAR arg_1, VAR arg_2) { operator()(arg_0, arg_1, arg_2); return Variant(); }
 	std::function<void(VAR, VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { static_cast<V_Method_3*>(p_method)->func(p_args[0], p_args[1], p_args[2]); }
 };
 
 struct V_Method_4 : public VoidMethod
 {
-	V_Method_4() { arg_count = 4; }
+	V_Method_4() { arg_count = 4; thunk = call_functor; }
 	V_Method_4(std::function<void(VAR, VAR, VAR, VAR)> p_func) : V_Method_4() { func = p_func; }
-	void operator()(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { func(arg_0, arg_1, arg_2, arg_3); }
-	Variant invoke_return(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { func(arg_0, arg_1, arg_2, arg_3); return Variant(); }
+	void operator()(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { Variant args[4] = { arg_0, arg_1, arg_2, arg_3 }; Variant result; call(args, result); }
+	Variant invoke_return(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { operator()(arg_0, arg_1, arg_2, arg_3); return Variant(); }
 	std::function<void(VAR, VAR, VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { static_cast<V_Method_4*>(p_method)->func(p_args[0], p_args[1], p_args[2], p_args[3]); }
 };
 
 // WITH RETURN
 
 struct R_Method_0 : public ReturnMethod
 {
-	R_Method_0() { arg_count = 0; }
+	R_Method_0() { arg_count = 0; thunk = call_functor; }
 	R_Method_0(std::function<VAR()> p_func) : R_Method_0() { func = p_func; }
-	VAR operator()() { return func(); }
-	VAR invoke_return() { func(); return func(); }
+	VAR operator()() { Variant result; call(NULL, result); return result; }
+	VAR invoke_return() { return operator()(); }
 	std::function<VAR()> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { r_result = static_cast<R_Method_0*>(p_method)->func(); }
 };
 
 struct R_Method_1 : public ReturnMethod
 {
-	R_Method_1() { arg_count = 1; }
+	R_Method_1() { arg_count = 1; thunk = call_functor; }
 	R_Method_1(std::function<VAR(VAR)> p_func) : R_Method_1() { func = p_func; }
-	VAR operator()(VAR arg_0) { return func(arg_0); }
-	VAR invoke_return(VAR arg_0) { return func(arg_0); }
+	VAR operator()(VAR arg_0) { Variant result; call(&arg_0, result); return result; }
+	VAR invoke_return(VAR arg_0) { return operator()(arg_0); }
 	std::function<VAR(VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { r_result = static_cast<R_Method_1*>(p_method)->func(p_args[0]); }
 };
 
 struct R_Method_2 : public ReturnMethod
 {
-	R_Method_2() { arg_count = 2; }
+	R_Method_2() { arg_count = 2; thunk = call_functor; }
 	R_Method_2(std::function<VAR(VAR, VAR)> p_func) : R_Method_2() { func = p_func; }
-	VAR operator()(VAR arg_0, VAR arg_1) { return func(arg_0, arg_1); }
-	VAR invoke_return(VAR arg_0, VAR arg_1) { return func(arg_0, arg_1); }
+	VAR operator()(VAR arg_0, VAR arg_1) { Variant args[2] = { arg_0, arg_1 }; Variant result; call(args, result); return result; }
+	VAR invoke_return(VAR arg_0, VAR arg_1) { return operator()(arg_0, arg_1); }
 	std::function<VAR(VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { r_result = static_cast<R_Method_2*>(p_method)->func(p_args[0], p_args[1]); }
 };
 
 struct R_Method_3 : public ReturnMethod
 {
-	R_Method_3() { arg_count = 3; }
+	R_Method_3() { arg_count = 3; thunk = call_functor; }
 	R_Method_3(std::function<VAR(VAR, VAR, VAR)> p_func) : R_Method_3() { func = p_func; }
-	VAR operator()(VAR arg_0, VAR arg_1, VAR arg_2) { return func(arg_0, arg_1, arg_2); }
-	VAR invoke_return(VAR arg_0, VAR arg_1, VAR arg_2) { return func(arg_0, arg_1, arg_2); }
+	VAR operator()(VAR arg_0, VAR arg_1, VAR arg_2) { Variant args[3] = { arg_0, arg_1, arg_2 }; Variant result; call(args, result); return result; }
+	VAR invoke_return(VAR arg_0, VAR arg_1, VAR arg_2) { return operator()(arg_0, arg_1, arg_2); }
 	std::function<VAR(VAR, VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { r_result = static_cast<R_Method_3*>(p_method)->func(p_args[0], p_args[1], p_args[2]); }
 };
 
 struct R_Method_4 : public ReturnMethod
 {
-	R_Method_4() { arg_count = 4; }
+	R_Method_4() { arg_count = 4; thunk = call_functor; }
 	R_Method_4(std::function<VAR(VAR, VAR, VAR, VAR)> p_func) : R_Method_4() { func = p_func; }
-	VAR operator()(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { return func(arg_0, arg_1, arg_2, arg_3); }
-	VAR invoke_return(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { return func(arg_0, arg_1, arg_2, arg_3); }
+	VAR operator()(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { Variant args[4] = { arg_0, arg_1, arg_2, arg_3 }; Variant result; call(args, result); return result; }
+	VAR invoke_return(VAR arg_0, VAR arg_1, VAR arg_2, VAR arg_3) { return operator()(arg_0, arg_1, arg_2, arg_3); }
 	std::function<VAR(VAR, VAR, VAR, VAR)> func;
+
+	static void call_functor(Method *p_method, const Variant *p_args, Variant &r_result) { r_result = static_cast<R_Method_4*>(p_method)->func(p_args[0], p_args[1], p_args[2], p_args[3]); }
 };
\ No newline at end of file
@@ -3,91 +3,91 @@
 #include "MethodMaster.h"
 
 //void method
-V_Method_1* MethodBuilder::reg_method(std::function<void(VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+V_Method_1* MethodBuilder::reg_method(std::function<void(VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	V_Method_1 *result = new V_Method_1;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
-V_Method_2* MethodBuilder::reg_method(std::function<void(VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+V_Method_2* MethodBuilder::reg_method(std::function<void(VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	V_Method_2 *result = new V_Method_2;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
-V_Method_3* MethodBuilder::reg_method(std::function<void(VAR, VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+V_Method_3* MethodBuilder::reg_method(std::function<void(VAR, VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	V_Method_3 *result = new V_Method_3;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
 
 //return method
-R_Method_1* MethodBuilder::reg_method(std::function<VAR(VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+R_Method_1* MethodBuilder::reg_method(std::function<VAR(VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	R_Method_1 *result = new R_Method_1;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
+	result->return_type = VariantType(p_binding.return_type);
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
-R_Method_2* MethodBuilder::reg_method(std::function<VAR(VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+R_Method_2* MethodBuilder::reg_method(std::function<VAR(VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	R_Method_2 *result = new R_Method_2;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
+	result->return_type = VariantType(p_binding.return_type);
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
-R_Method_3* MethodBuilder::reg_method(std::function<VAR(VAR, VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+R_Method_3* MethodBuilder::reg_method(std::function<VAR(VAR, VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
 {
 	R_Method_3 *result = new R_Method_3;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
+	result->return_type = VariantType(p_binding.return_type);
 	result->func = p_func;
 	result->name = name;
 	result->inherits_from = var_type;
+	apply(result, p_binding);
 	MMASTER->register_method(var_type, result);
 	return result;
 }
 
+void MethodBuilder::apply(Method *p_method, const MethodBinding &p_binding)
+{
+	p_method->param_types = p_binding.arg_typenames;
+	p_method->is_const = p_binding.is_const;
+	p_method->thunk = p_binding.thunk;
+	p_method->target = p_binding.target;
+}
+
 //static void func
 V_Method_0* MethodBuilder::reg_static_func(std::function<void()> p_func, const StringName &name, const ParameterNames &p_args)
 {
 	V_Method_0* result = new V_Method_0;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -97,8 +97,6 @@ V_Method_1* MethodBuilder::reg_static_func(std::function<void(VAR)> p_func, cons
 {
 	V_Method_1* result = new V_Method_1;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -108,8 +106,6 @@ V_Method_2* MethodBuilder::reg_static_func(std::function<void(VAR, VAR)> p_func,
 {
 	V_Method_2* result = new V_Method_2;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -121,9 +117,6 @@ R_Method_0* MethodBuilder::reg_static_func(std::function<VAR()> p_func, const St
 {
 	R_Method_0* result = new R_Method_0;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -133,9 +126,6 @@ R_Method_1* MethodBuilder::reg_static_func(std::function<VAR(VAR)> p_func, const
 {
 	R_Method_1* result = new R_Method_1;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -145,9 +135,6 @@ R_Method_2* MethodBuilder::reg_static_func(std::function<VAR(VAR, VAR)> p_func,
 {
 	R_Method_2* result = new R_Method_2;
 	result->param_names = p_args;
-	result->param_types = MethodBinder::get_singleton()->arg_typenames;
-	result->is_const = MethodBinder::get_singleton()->is_const;
-	result->return_type = VariantType(MethodBinder::get_singleton()->return_type);
 	result->func = p_func;
 	result->name = name;
 	MMASTER->register_static_func(name, result);
@@ -62,7 +62,7 @@
 //register method
 #define REG_METHOD_FULL(TYPE, TYPENAME, METHOD) \
 	MethodBuilder::reg_method( \
-		FunctorBuilder::build(MethodBinder::bind(&TYPE::METHOD)), \
+		MethodBinder::bind(&TYPE::METHOD), \
 		StringName(#METHOD), \
 		ParameterNames(), \
 		VariantType(StringName(TYPENAME)))
@@ -73,6 +73,14 @@
 #define REG_METHOD_NO(TYPE, METHOD) \
 	REG_METHOD_FULL(TYPE, #TYPE, METHOD)
 
+//register one overload of an overloaded method, picked by its return and argument types
+#define REG_METHOD_OVRLD(METHOD, RETURN, ...) \
+	MethodBuilder::reg_method( \
+		MethodBinder::bind(static_cast<RETURN(CLASSNAME::*)(__VA_ARGS__)>(&CLASSNAME::METHOD)), \
+		StringName(#METHOD), \
+		ParameterNames(), \
+		VariantType(StringName(CLASSNAME::get_type_name_static().get_source())))
+
 //register property (with getter and setter)
 #define REG_PROPERTY_FULL(TYPE, TYPENAME, NAME) \
 	MethodBuilder::register_property( \
@@ -196,6 +204,35 @@ struct ConstructorBuilder
 	}
 };
 
+//what a registered Method takes over from the member function it binds, returned by
+//MethodBinder::bind so two binds in one expression cannot mix up their results
+struct MethodBinding
+{
+	template<typename F>
+	MethodBinding(F p_function, MethodThunk p_thunk, bool p_const)
+	{
+		thunk = p_thunk;
+		target.set(p_function);
+		is_const = p_const;
+	}
+
+	bool is_const;
+	ParameterTypes arg_typenames;
+	String return_type;
+
+	MethodThunk thunk;
+	MethodTarget target;
+};
+
+template<typename F>
+struct BoundMethod : MethodBinding
+{
+	template<typename M>
+	BoundMethod(M p_function, MethodThunk p_thunk, bool p_const) : MethodBinding(p_function, p_thunk, p_const) { }
+
+	std::function<F> func;
+};
+
 struct MethodBinder
 {
 	//=========================================================================
@@ -203,36 +240,36 @@ struct MethodBinder
 	//=========================================================================
 
 	template<typename R, typename T>
-	static std::function<VAR(T*)> bind(R(T::*f) ())
+	static BoundMethod<VAR(T*)> bind(R(T::*f) ())
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = false;
+		BoundMethod<VAR(T*)> result(f, &call_return_0<R(T::*)(), T>, false);
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1);
 
-		return std::bind(f, std::placeholders::_1);
+		return result;
 	}
 
 	template<typename R, typename T, typename A_0>
-	static std::function<VAR(T*, A_0)> bind(R(T::*f) (A_0))
+	static BoundMethod<VAR(T*, A_0)> bind(R(T::*f) (A_0))
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = false;
+		BoundMethod<VAR(T*, A_0)> result(f, &call_return_1<R(T::*)(A_0), T>, false);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2);
+		return result;
 	}
 
 	template<typename R, typename T, typename A_0, typename A_1>
-	static std::function<VAR(T*, A_0, A_1)> bind(R(T::*f) (A_0, A_1))
+	static BoundMethod<VAR(T*, A_0, A_1)> bind(R(T::*f) (A_0, A_1))
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->arg_typenames.push_back(GetType<A_1>());
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = false;
+		BoundMethod<VAR(T*, A_0, A_1)> result(f, &call_return_2<R(T::*)(A_0, A_1), T>, false);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.arg_typenames.push_back(GetType<A_1>());
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		return result;
 	}
 
 	//=========================================================================
@@ -240,33 +277,33 @@ struct MethodBinder
 	//=========================================================================
 
 	template<typename T>
-	static std::function<void(T*)> bind(void(T::*f) ())
+	static BoundMethod<void(T*)> bind(void(T::*f) ())
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->is_const = false;
+		BoundMethod<void(T*)> result(f, &call_void_0<void(T::*)(), T>, false);
+		result.func = std::bind(f, std::placeholders::_1);
 
-		return std::bind(f, std::placeholders::_1);
+		return result;
 	}
 
 	template<typename T, typename A_0>
-	static std::function<void(T*, A_0)> bind(void(T::*f) (A_0))
+	static BoundMethod<void(T*, A_0)> bind(void(T::*f) (A_0))
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->is_const = false;
+		BoundMethod<void(T*, A_0)> result(f, &call_void_1<void(T::*)(A_0), T>, false);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2);
+		return result;
 	}
 
 	template<typename T, typename A_0, typename A_1>
-	static std::function<void(T*, A_0, A_1)> bind(void(T::*f) (A_0, A_1))
+	static BoundMethod<void(T*, A_0, A_1)> bind(void(T::*f) (A_0, A_1))
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->arg_typenames.push_back(GetType<A_1>());
-		get_singleton()->is_const = false;
+		BoundMethod<void(T*, A_0, A_1)> result(f, &call_void_2<void(T::*)(A_0, A_1), T>, false);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.arg_typenames.push_back(GetType<A_1>());
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		return result;
 	}
 
 	//=========================================================================
@@ -274,36 +311,36 @@ struct MethodBinder
 	//=========================================================================
 
 	template<typename R, typename T>
-	static std::function<VAR(T*)> bind(R(T::*f) () const)
+	static BoundMethod<VAR(T*)> bind(R(T::*f) () const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = true;
+		BoundMethod<VAR(T*)> result(f, &call_return_0<R(T::*)() const, T>, true);
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1);
 
-		return std::bind(f, std::placeholders::_1);
+		return result;
 	}
 
 	template<typename R, typename T, typename A_0>
-	static std::function<VAR(T*, A_0)> bind(R(T::*f) (A_0) const)
+	static BoundMethod<VAR(T*, A_0)> bind(R(T::*f) (A_0) const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = true;
+		BoundMethod<VAR(T*, A_0)> result(f, &call_return_1<R(T::*)(A_0) const, T>, true);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2);
+		return result;
 	}
 
 	template<typename R, typename T, typename A_0, typename A_1>
-	static std::function<VAR(T*, A_0, A_1)> bind(R(T::*f) (A_0, A_1) const)
+	static BoundMethod<VAR(T*, A_0, A_1)> bind(R(T::*f) (A_0, A_1) const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->arg_typenames.push_back(GetType<A_1>());
-		get_singleton()->return_type = GetType<R>();
-		get_singleton()->is_const = true;
+		BoundMethod<VAR(T*, A_0, A_1)> result(f, &call_return_2<R(T::*)(A_0, A_1) const, T>, true);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.arg_typenames.push_back(GetType<A_1>());
+		result.return_type = GetType<R>();
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		return result;
 	}
 
 	//=========================================================================
@@ -311,45 +348,80 @@ struct MethodBinder
 	//=========================================================================
 
 	template<typename T>
-	static std::function<void(T*)> bind(void(T::*f) () const)
+	static BoundMethod<void(T*)> bind(void(T::*f) () const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->is_const = true;
+		BoundMethod<void(T*)> result(f, &call_void_0<void(T::*)() const, T>, true);
+		result.func = std::bind(f, std::placeholders::_1);
 
-		return std::bind(f, std::placeholders::_1);
+		return result;
 	}
 
 	template<typename T, typename A_0>
-	static std::function<void(T*, A_0)> bind(void(T::*f) (A_0) const)
+	static BoundMethod<void(T*, A_0)> bind(void(T::*f) (A_0) const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->is_const = true;
+		BoundMethod<void(T*, A_0)> result(f, &call_void_1<void(T::*)(A_0) const, T>, true);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2);
+		return result;
 	}
 
 	template<typename T, typename A_0, typename A_1>
-	static std::function<void(T*, A_0, A_1)> bind(void(T::*f) (A_0, A_1) const)
+	static BoundMethod<void(T*, A_0, A_1)> bind(void(T::*f) (A_0, A_1) const)
 	{
-		get_singleton()->arg_typenames.clear();
-		get_singleton()->arg_typenames.push_back(GetType<A_0>());
-		get_singleton()->arg_typenames.push_back(GetType<A_1>());
-		get_singleton()->is_const = true;
+		BoundMethod<void(T*, A_0, A_1)> result(f, &call_void_2<void(T::*)(A_0, A_1) const, T>, true);
+		result.arg_typenames.push_back(GetType<A_0>());
+		result.arg_typenames.push_back(GetType<A_1>());
+		result.func = std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
-		return std::bind(f, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		return result;
 	}
 
-	static MethodBinder* get_singleton()
+	//=========================================================================
+	//THUNKS: call the bound member function straight from the argument span
+	//=========================================================================
+
+	template<typename F, typename T>
+	static void call_return_0(Method *p_method, const Variant *p_args, Variant &r_result)
 	{
-		static MethodBinder mb;
-		return &mb;
+		T *object = p_args[0];
+		r_result = (object->*p_method->target.get<F>())();
 	}
 
-	//metadata of last bounded function
-	bool is_const;
-	ParameterTypes arg_typenames;
-	String return_type;
+	template<typename F, typename T>
+	static void call_return_1(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		T *object = p_args[0];
+		r_result = (object->*p_method->target.get<F>())(p_args[1]);
+	}
+
+	template<typename F, typename T>
+	static void call_return_2(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		T *object = p_args[0];
+		r_result = (object->*p_method->target.get<F>())(p_args[1], p_args[2]);
+	}
+
+	template<typename F, typename T>
+	static void call_void_0(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		T *object = p_args[0];
+		(object->*p_method->target.get<F>())();
+	}
+
+	template<typename F, typename T>
+	static void call_void_1(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		T *object = p_args[0];
+		(object->*p_method->target.get<F>())(p_args[1]);
+	}
+
+	template<typename F, typename T>
+	static void call_void_2(Method *p_method, const Variant *p_args, Variant &r_result)
+	{
+		T *object = p_args[0];
+		(object->*p_method->target.get<F>())(p_args[1], p_args[2]);
+	}
 };
 
 class MethodBuilder
@@ -358,15 +430,27 @@ public:
 #define ARG_ARRAY ParameterNames p_args
 #define VAR_TYPE VariantType var_type
 
+	//bound member function
+	template<typename F>
+	static auto reg_method(const BoundMethod<F> &p_bound, const StringName &name, const ParameterNames &p_args, VAR_TYPE)
+	{
+		return reg_method(FunctorBuilder::build(p_bound.func), p_bound, name, p_args, var_type);
+	}
+
 	//void method
-	static V_Method_1* reg_method(std::function<void(VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
-	static V_Method_2* reg_method(std::function<void(VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
-	static V_Method_3* reg_method(std::function<void(VAR, VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static V_Method_1* reg_method(std::function<void(VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static V_Method_2* reg_method(std::function<void(VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static V_Method_3* reg_method(std::function<void(VAR, VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
 
 	//return method
-	static R_Method_1* reg_method(std::function<VAR(VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
-	static R_Method_2* reg_method(std::function<VAR(VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
-	static R_Method_3* reg_method(std::function<VAR(VAR, VAR, VAR)> p_func, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static R_Method_1* reg_method(std::function<VAR(VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static R_Method_2* reg_method(std::function<VAR(VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+	static R_Method_3* reg_method(std::function<VAR(VAR, VAR, VAR)> p_func, const MethodBinding &p_binding, const StringName &name, const ParameterNames &p_args, VAR_TYPE);
+
+private:
+	static void apply(Method *p_method, const MethodBinding &p_binding);
+
+public:
 
 	//static void method
 	static V_Method_0* reg_static_func(std::function<void()> p_func, const StringName &name, const ParameterNames &p_args);
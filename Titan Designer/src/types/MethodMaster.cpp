@@ -4,27 +4,42 @@
 #include "MethodBuilder.h"
 
 #include "math/Rect.h"
+#include "core/CoreNames.h"
 
 MethodMaster *MethodMaster::method_master;
 
+ObjectCallables::ObjectCallables()
+{
+	parent = NULL;
+}
+
 Method* ObjectCallables::get_method_by_name(const StringName &name)
 {
-	for (int c = 0; c < methods.size(); c++)
-		if (methods[c]->name == name)
-			return methods[c];
+	for (ObjectCallables *oc = this; oc; oc = oc->parent)
+		if (Method *m = oc->methods.get(name))
+			return m;
 
 	return NULL;
 }
 
 Property* ObjectCallables::get_getsetter_by_name(const StringName &name)
 {
-	for (int c = 0; c < properties.size(); c++)
-		if (properties[c]->var_name == name)
-			return properties[c];
+	for (ObjectCallables *oc = this; oc; oc = oc->parent)
+		if (Property *p = oc->properties.get(name))
+			return p;
 
 	return NULL;
 }
 
+bool ObjectCallables::has_signal(const StringName &p_signal) const
+{
+	for (const ObjectCallables *oc = this; oc; oc = oc->parent)
+		if (oc->signal_names.contains(p_signal))
+			return true;
+
+	return false;
+}
+
 TConstructor* ObjectCallables::get_constructor_by_params(int param_count)
 {
 	for (int c = 0; c < constructors.size(); c++)
@@ -54,30 +69,46 @@ void MethodMaster::init()
 	method_master->add_inherited_methods();
 }
 
+//links every type to the callables of its base type, so inherited members are found
+//through the parents instead of being copied into the tables of all derived types
 void MethodMaster::add_inherited_methods()
 {	
-	for (std::pair<const StringName, ObjectType> &o : TypeManager::get_singleton()->object_types)
+	for (std::pair<StringName, ObjectType> &o : TypeManager::get_singleton()->object_types)
 	{
 		Array<String> a = o.second.path.split('/');
 
-		// do not add the object's own methods again
-		a.removelast();
+		for (int c = 1; c < a.size(); c++)
+			add_callables(VariantType(a[c]))->parent = add_callables(VariantType(a[c - 1]));
+	}
+
+	build_lifecycle_tables();
+}
+
+//the first class in a type path that declares a callback introduces it with an empty
+//body, the type only does work when a class after that one declares it again
+void MethodMaster::build_lifecycle_tables()
+{
+	TypeManager *types = TypeManager::get_singleton();
+
+	for (std::pair<StringName, ObjectType> &o : types->object_types)
+	{
+		ObjectCallables *oc = add_callables(VariantType(o.first));
+		Array<String> a = o.second.path.split('/');
+		int declarations[LIFECYCLE_COUNT] = { };
 
 		for (int c = 0; c < a.size(); c++)
 		{
-			VariantType t = a[c];
-
-			for (Method *method : object_callables[t].methods)
-			{
-				method->inherits_from = t;
-				register_method(o.second.name, method);
-			}
-			
-			for (Property *property : object_callables[t].properties)
-			{
-				property->inherits_from = t;
-				register_property(o.second.name, property); 
-			}
+			ObjectType *ancestor = types->object_types.find(a[c]);
+
+			for (int i = 0; ancestor && i < LIFECYCLE_COUNT; i++)
+				if (ancestor->declared_callbacks & (1u << i))
+					declarations[i]++;
+		}
+
+		for (int i = 0; i < LIFECYCLE_COUNT; i++)
+		{
+			oc->lifecycle.methods[i] = oc->get_method_by_name(get_lifecycle_name(static_cast<Lifecycle>(i)));
+			oc->lifecycle.native[i] = declarations[i] > 1;
 		}
 	}
 }
@@ -191,31 +222,29 @@ void MethodMaster::add_static_functions()
 
 void MethodMaster::register_constant(VariantType type, const ConstantMember &p_constant)
 {
-	object_callables[type].constants.push_back(p_constant);
+	add_callables(type)->constants.push_back(p_constant);
 }
 
 void MethodMaster::register_singleton(VariantType type, Variant p_singleton)
 {
-	object_callables[type].singleton = p_singleton;
+	add_callables(type)->singleton = p_singleton;
 }
 
 //register
 void MethodMaster::register_method(VariantType type, Method *method)
 {
-	if (!method_exists(type, method->name))
-		object_callables[type].methods.push_back(method);
+	add_callables(type)->methods.add(method->name, method);
 }
 
 void MethodMaster::register_property(VariantType type, Property *getset)
 {
-	if (!property_exists(type, getset->var_name))
-		object_callables[type].properties.push_back(getset);
+	add_callables(type)->properties.add(getset->var_name, getset);
 }
 
 void MethodMaster::register_constructor(VariantType type, TConstructor *cstr)
 {
 	if (!constructor_exists(type, cstr->arg_count))
-		object_callables[type].constructors.push_back(cstr);
+		add_callables(type)->constructors.push_back(cstr);
 }
 
 void MethodMaster::register_static_func(StringName name, Method *method)
@@ -225,99 +254,111 @@ void MethodMaster::register_static_func(StringName name, Method *method)
 
 void MethodMaster::register_signal(const VariantType &p_type, const StringName &p_signal)
 {
-	object_callables[p_type].signal_names.push_back(p_signal);
+	add_callables(p_type)->signal_names.push_back(p_signal);
 }
 
 //does exist
 bool MethodMaster::method_exists(VariantType type, const StringName &name)
 {
-	if (!object_callables.contains(type))
-		return false;
-
-	for (Method *m : object_callables[type].methods)
-		if (m->name == name)
-			return true;
-
-	return false;
+	return get_method(type, name) != NULL;
 }
 bool MethodMaster::property_exists(VariantType type, const StringName &name)
 {
-	if (!object_callables.contains(type))
-		return false;
-
-	for (Property *gs : object_callables[type].properties)
-		if (gs->var_name == name)
-			return true;
-
-	return false;
+	return get_property(type, name) != NULL;
 }
 bool MethodMaster::constructor_exists(VariantType type, int argc)
 {
-	if (!object_callables.contains(type))
-		return false;
-
-	for (TConstructor * m : object_callables[type].constructors)
-		if (m->arg_count == argc)
-			return true;
-
-	return false;
+	return get_constructor(type, argc) != NULL;
 }
 
 bool MethodMaster::signal_exists(const VariantType & p_type, const StringName & p_signal)
 {
-	if (!object_callables.contains(p_type))
-		return false;
-
-
-	Array<String> a = TYPEMAN->get_object_type(p_type.get_type_name()).path.split('/');
+	ObjectCallables *oc = get_callables(p_type);
 
-	for (int c = 0; c < a.size(); c++)
-	{
-		if (object_callables[VariantType(a[c])].signal_names.contains(p_signal))
-			return true;
-	}
-
-	return false;
+	return oc && oc->has_signal(p_signal);
 }
 
 //get
 Method* MethodMaster::get_method(VariantType type, const StringName &name)
 {
-	if (object_callables.contains(type))
-	{
-		Method* m = object_callables[type].get_method_by_name(name);
-		return object_callables[type].get_method_by_name(name);
-	}
-	else
-		return NULL;
+	ObjectCallables *oc = get_callables(type);
+
+	return oc ? oc->get_method_by_name(name) : NULL;
 }
 Property* MethodMaster::get_property(VariantType type, const StringName &name)
 {
-	if (object_callables.contains(type))
-		return object_callables[type].get_getsetter_by_name(name);
-	else
-		return NULL;
+	ObjectCallables *oc = get_callables(type);
+
+	return oc ? oc->get_getsetter_by_name(name) : NULL;
 }
 TConstructor* MethodMaster::get_constructor(VariantType type, int param_count)
 {
-	if (object_callables.contains(type))
-		return object_callables[type].get_constructor_by_params(param_count);
-	else
-		return NULL;
+	ObjectCallables *oc = get_callables(type);
+
+	return oc ? oc->get_constructor_by_params(param_count) : NULL;
 }
 
 Variant MethodMaster::get_singleton(VariantType p_type)
 {
-	if (object_callables.contains(p_type))
-		return object_callables[p_type].singleton;
-	else
-		return NULL;
+	ObjectCallables *oc = get_callables(p_type);
+
+	return oc ? oc->singleton : NULL_VAR;
+}
+
+const LifecycleTable* MethodMaster::get_lifecycle(const VariantType &p_type) const
+{
+	static const LifecycleTable empty;
+	ObjectCallables *oc = get_callables(p_type);
+
+	return oc ? &oc->lifecycle : &empty;
+}
+
+StringName MethodMaster::get_lifecycle_name(Lifecycle p_callback)
+{
+	switch (p_callback)
+	{
+	case LIFECYCLE_READY:
+		return CORE_NAMES->ready;
+
+	case LIFECYCLE_UPDATE:
+		return CORE_NAMES->update;
+
+	case LIFECYCLE_DRAW:
+		return CORE_NAMES->draw;
+
+	case LIFECYCLE_HANDLE_EVENT:
+		return CORE_NAMES->handle_event;
+
+	default:
+		return StringName();
+	}
+}
+
+ObjectCallables* MethodMaster::get_callables(const VariantType &p_type) const
+{
+	int id = p_type;
+
+	return id >= 0 && id < object_callables.size() ? object_callables[id] : NULL;
+}
+
+ObjectCallables* MethodMaster::add_callables(const VariantType &p_type)
+{
+	int id = p_type;
+
+	while (object_callables.size() <= id)
+		object_callables.push_back(NULL);
+
+	if (!object_callables[id])
+		object_callables[id] = new ObjectCallables;
+
+	return object_callables[id];
 }
 
 void MethodMaster::clean()
 {
-	for (std::pair<const int, ObjectCallables> &oc : MMASTER->object_callables)
-		oc.second.free();
+	for (ObjectCallables *oc : MMASTER->object_callables)
+		if (oc)
+			oc->free();
 }
 
 MethodMaster* MethodMaster::get_method_master()
@@ -325,30 +366,49 @@ MethodMaster* MethodMaster::get_method_master()
 	return method_master;
 }
 
+//the type itself first, then its ancestors starting at the root
+static Array<ObjectCallables*> get_lineage(ObjectCallables *p_callables)
+{
+	Array<ObjectCallables*> lineage;
+	lineage.push_back(p_callables);
+
+	for (ObjectCallables *oc = p_callables->parent; oc; oc = oc->parent)
+		lineage.insert(1, oc);
+
+	return lineage;
+}
+
 Array<StringName> MethodMaster::list_method_names(VariantType type)
 {
-	if (!type.is_def())
+	ObjectCallables *callables = get_callables(type);
+
+	if (!type.is_def() || !callables)
 		return Array<StringName>();
 
 	Array<StringName> result;
 
-	for (Method *m : object_callables[type].methods)
-		result.push_back(m->name);
+	//overridden methods are listed once
+	for (ObjectCallables *oc : get_lineage(callables))
+		for (Method *m : oc->methods.get_values())
+			if (callables->get_method_by_name(m->name) == m)
+				result.push_back(m->name);
 
 	return result;
 }
 
 Array<StringName> MethodMaster::list_property_names(VariantType type)
 {
-	if (!type.is_def())
-		return Array<StringName>();
-
+	ObjectCallables *callables = get_callables(type);
 
+	if (!type.is_def() || !callables)
+		return Array<StringName>();
 
 	Array<StringName> result;
 
-	for (Property *m : object_callables[type].properties)
-		result.push_back(m->var_name);
+	for (ObjectCallables *oc : get_lineage(callables))
+		for (Property *p : oc->properties.get_values())
+			if (callables->get_getsetter_by_name(p->var_name) == p)
+				result.push_back(p->var_name);
 
 	return result;
 }
@@ -7,6 +7,8 @@
 #include "Signal.h"
 #include "core/Property.h"
 #include "TConstructor.h"
+#include "MemberTable.h"
+#include "Lifecycle.h"
 
 #define MMASTER MethodMaster::get_method_master()
 
@@ -25,19 +27,29 @@ struct ConstantMember
 class ObjectCallables
 {
 public:
+	ObjectCallables();
+
+	//methods, properties and signals are looked up in this type first, then in its parents
 	Method* get_method_by_name(const StringName &name);
 	Property* get_getsetter_by_name(const StringName &name);
 	TConstructor* get_constructor_by_params(int param_count);
+	bool has_signal(const StringName &p_signal) const;
 
 	void free();
 	
-	Vector<Method> methods;
-	Vector<Property> properties;
+	MemberTable<Method> methods;
+	MemberTable<Property> properties;
 	Vector<TConstructor> constructors;
 	Array<ConstantMember> constants;
 	Array<StringName> signal_names;
 
 	Variant singleton;
+
+	//filled after all types registered their methods
+	LifecycleTable lifecycle;
+
+	//the callables of the base type, inherited members are not copied into this one
+	ObjectCallables *parent;
 };
 
 class MethodMaster
@@ -65,6 +77,10 @@ public:
 	TConstructor *get_constructor(VariantType type, int param_count);
 	Variant get_singleton(VariantType p_type);
 
+	//the lifecycle callbacks of a type, an empty table for types without callables
+	const LifecycleTable* get_lifecycle(const VariantType &p_type) const;
+	static StringName get_lifecycle_name(Lifecycle p_callback);
+
 	Array<StringName> list_method_names(VariantType type);
 	Array<StringName> list_property_names(VariantType type);
 	Array<StringName> list_constructor_names(VariantType type);
@@ -77,7 +93,13 @@ public:
 	static MethodMaster* get_method_master();
 
 private:
-	Dictionary<int, ObjectCallables> object_callables;
+	void build_lifecycle_tables();
+
+	ObjectCallables* get_callables(const VariantType &p_type) const;
+	ObjectCallables* add_callables(const VariantType &p_type);
+
+	//indexed by type id
+	Array<ObjectCallables*> object_callables;
 
 	static MethodMaster *method_master;
 };
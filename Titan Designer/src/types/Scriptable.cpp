@@ -1,16 +1,35 @@
 #include "Scriptable.h"
 
+#include <mutex>
+
 #include "core/variant/Variant.h"
 #include "core/titanscript/TitanScript.h"
+#include "core/titanscript/CommandBuffer.h"
+#include "core/titanscript/ScriptScheduler.h"
 #include "core/Object.h"
 
+//two queues so signals deferred while flushing go to the next frame
+static CommandBuffer deferred_signals[2];
+static int deferred_queue = 0;
+static std::mutex deferred_mutex;
+
 Scriptable::Scriptable()
 {
+	script = NULL;
+	lifecycle = NULL;
 }
 
 
 Scriptable::~Scriptable()
 {
+	//suspended scripts of this object and the ones waiting on its signals would resume on a deleted object
+	if (SCHEDULER)
+		SCHEDULER->cancel(this);
+
+	std::lock_guard<std::mutex> lock(deferred_mutex);
+
+	deferred_signals[0].forget(this);
+	deferred_signals[1].forget(this);
 }
 
 void Scriptable::set_script(TitanScript *p_script)
@@ -32,7 +51,7 @@ Variant Scriptable::run(const StringName &name, const Arguments& args)
 	if (!m && script)
 		return script->RunFunction(name, args);
 	else if (m)
-		return m->operator()(args);
+		return call_method(m, args);
 	else
 	{
 		T_ERROR("Invalid function call");
@@ -45,16 +64,72 @@ bool Scriptable::method_exists(const StringName &name)
 	return has_script() && script->FunctionExists(name);
 }
 
+//the type is only known once the object is constructed
+const LifecycleTable* Scriptable::get_lifecycle()
+{
+	if (!lifecycle)
+		lifecycle = MMASTER->get_lifecycle(get_type());
+
+	return lifecycle;
+}
+
+bool Scriptable::implements(Lifecycle p_callback)
+{
+	const LifecycleTable *table = get_lifecycle();
+	return table->native[p_callback] || table->methods[p_callback] || (script && script->implements(p_callback));
+}
+
+Variant Scriptable::run_callback(Lifecycle p_callback, const Arguments &args)
+{
+	if (script && script->implements(p_callback))
+		return script->run_callback(p_callback, args);
+
+	//a class that declares the callback runs it itself, after this
+	const LifecycleTable *table = get_lifecycle();
+
+	if (table->methods[p_callback] && !table->native[p_callback])
+		return call_method(table->methods[p_callback], args);
+
+	return NULL_VAR;
+}
+
+Variant Scriptable::call_method(Method *p_method, const Arguments &args)
+{
+	Variant call_args[MAX_METHOD_ARGS];
+	Variant result;
+
+	if (args.size() + 1 != p_method->arg_count)
+	{
+		T_ERROR("Number of arguments does not match for method: " + p_method->name);
+		return NULL_VAR;
+	}
+
+	call_args[0] = this;
+
+	for (int c = 0; c < args.size(); c++)
+		call_args[c + 1] = args[c];
+
+	p_method->call(call_args, result);
+	return result;
+}
+
 Variant Scriptable::get(const StringName &name)
 {
 	Property *p = MMASTER->get_property(get_type(), name);
-	return p->get->operator() (Variant(this));
+	Variant object = this;
+	Variant result;
+
+	p->get->call(&object, result);
+	return result;
 }
 
 void Scriptable::set(const StringName &name, const Variant &value)
 {
 	Property *p = MMASTER->get_property(get_type(), name);
-	p->set->operator() (Variant(this), Variant(value));
+	Variant args[] = { this, value };
+	Variant result;
+
+	p->set->call(args, result);
 }
 
 void Scriptable::disconnect(const StringName& p_signalname)
@@ -138,7 +213,14 @@ void Scriptable::connect_signal(const StringName& p_in, Scriptable* p_object, co
 
 void Scriptable::emit_signal(const StringName & p_name)
 {
-	signals[p_name].emit();
+	if (CommandBuffer::current)						//Parallel update, emitted after the batch
+	{
+		CommandBuffer::current->emit(this, p_name);
+		return;
+	}
+
+	if (Signal *signal = signals.find(p_name))
+		signal->emit();
 	
 	if (method_exists(p_name))
 		run(p_name, {});
@@ -146,16 +228,51 @@ void Scriptable::emit_signal(const StringName & p_name)
 
 void Scriptable::emit_signal(const StringName & p_name, Variant arg_0)
 {
-	signals[p_name].emit(arg_0);
+	if (CommandBuffer::current)
+	{
+		CommandBuffer::current->emit(this, p_name, arg_0);
+		return;
+	}
+
+	if (Signal *signal = signals.find(p_name))
+		signal->emit(arg_0);
 
 	if (method_exists(p_name))
 		run(p_name, { arg_0 });
 }
 
+void Scriptable::emit_signal_deferred(const String &p_name)
+{
+	std::lock_guard<std::mutex> lock(deferred_mutex);
+	deferred_signals[deferred_queue].emit(this, p_name);
+}
+
+void Scriptable::emit_signal_deferred(const String &p_name, const Variant &arg_0)
+{
+	std::lock_guard<std::mutex> lock(deferred_mutex);
+	deferred_signals[deferred_queue].emit(this, p_name, arg_0);
+}
+
+void Scriptable::flush_deferred_signals()
+{
+	CommandBuffer *queue;
+
+	{
+		std::lock_guard<std::mutex> lock(deferred_mutex);
+
+		queue = &deferred_signals[deferred_queue];
+		deferred_queue = 1 - deferred_queue;
+	}
+
+	if (queue->size())
+		CommandBuffer::apply({ queue });
+}
+
 #undef CLASSNAME
 #define CLASSNAME Scriptable
 
 void Scriptable::bind_methods()
 {
 	REG_PROPERTY(script);
+	REG_METHOD_OVRLD(emit_signal_deferred, void, const String&);
 }
@@ -22,6 +22,13 @@ public:
 	Variant run(const StringName &name, const Arguments& args);
 	bool method_exists(const StringName &name);
 
+	//whether the class or the script does anything for the callback, objects that do not
+	//are skipped by the traversals
+	bool implements(Lifecycle p_callback);
+
+	//runs the script callback, the bound method of the same name when the script does not have it
+	Variant run_callback(Lifecycle p_callback, const Arguments &args);
+
 	Variant get(const StringName &name);
 	void set(const StringName &name, const Variant &value);
 
@@ -34,6 +41,13 @@ public:
 	void emit_signal(const StringName& p_name);
 	void emit_signal(const StringName & p_name, Variant arg_0);
 
+	//queued and emitted at the end of the frame, dropped when the object is deleted first
+	void emit_signal_deferred(const String &p_name);
+	void emit_signal_deferred(const String &p_name, const Variant &arg_0);
+
+	//emits the queued signals, signals deferred by them are emitted next frame
+	static void flush_deferred_signals();
+
 	static void bind_methods();
 
 	Dictionary<StringName, Signal> signals;
@@ -42,6 +56,10 @@ protected:
 	bool has_script() const { return script; }
 
 private:
+	const LifecycleTable* get_lifecycle();
+	Variant call_method(Method *p_method, const Arguments &args);
+
 	TitanScript *script;
+	const LifecycleTable *lifecycle;
 };
 
@@ -2,12 +2,21 @@
 
 #include "core/TMessage.h"
 #include "core/variant/VariantType.h"
+#include "core/CoreNames.h"
 
 TypeManager *TypeManager::singleton;
 
 
 TypeManager::TypeManager()
 {
+	//in the order of Variant::Type
+	StringName builtin[] = {
+		CORE_TYPE(Null), CORE_TYPE(Bool), CORE_TYPE(Int), CORE_TYPE(Float), CORE_TYPE(String),
+		CORE_TYPE(vec2), CORE_TYPE(vec3), CORE_TYPE(vec4), CORE_TYPE(mat4), CORE_TYPE(Color),
+		CORE_TYPE(Transform), CORE_TYPE(Object), CORE_TYPE(Array) };
+
+	for (const StringName &name : builtin)
+		get_type_id(name);
 }
 
 
@@ -25,6 +34,49 @@ VariantType TypeManager::get_type(const StringName &name)
 	return types[name];
 }
 
+int TypeManager::get_type_id(const StringName &name)
+{
+	std::lock_guard<std::mutex> lock(id_mutex);
+
+	if (type_ids.contains(name))
+		return type_ids[name];
+
+	int id = type_names.size();
+
+	type_ids[name] = id;
+	type_names.push_back(name);
+	return id;
+}
+
+StringName TypeManager::get_type_name(int p_id)
+{
+	std::lock_guard<std::mutex> lock(id_mutex);
+
+	if (p_id < 0 || p_id >= type_names.size())
+		return CORE_TYPE(Null);
+
+	return type_names[p_id];
+}
+
+bool TypeManager::derives_from(int p_id, int p_ancestor) const
+{
+	if (p_id == p_ancestor)
+		return true;
+
+	return p_id < ancestors.size() && ancestors[p_id].contains(p_ancestor);
+}
+
+void TypeManager::add_ancestors(int p_id, const String &p_path)
+{
+	while (ancestors.size() <= p_id)
+		ancestors.push_back(TypeSet());
+
+	Array<String> path = p_path.split('/');
+
+	for (int c = 0; c < path.size(); c++)
+		ancestors[p_id].add(get_type_id(path[c]));
+}
+
 VariantType TypeManager::get_type(void *ptr)
 {
 	return get_type(get_name(ptr));
@@ -1,15 +1,39 @@
 #pragma once
 
+#include <mutex>
+
 #include "String.h"
-#include "core/Dictionary.h"
+#include "core/HashMap.h"
 #include "core/variant/Variant.h"
 
+#include "Lifecycle.h"
+
 #define TYPEMAN TypeManager::get_singleton()
 #define GETTYPE TYPEMAN->get_type
 #define GETNAME TYPEMAN->get_name
 
 class VariantType;
 
+//one bit per type id, the ancestors of a type including the type itself
+struct TypeSet
+{
+	bool contains(int p_id) const
+	{
+		int word = p_id / 32;
+		return p_id >= 0 && word < bits.size() && (bits[word] >> (p_id % 32)) & 1;
+	}
+
+	void add(int p_id)
+	{
+		while (bits.size() <= p_id / 32)
+			bits.push_back(0);
+
+		bits[p_id / 32] |= 1u << (p_id % 32);
+	}
+
+	Array<unsigned> bits;
+};
+
 struct ObjectType
 {
 	ObjectType() { }
@@ -18,6 +42,10 @@ struct ObjectType
 	StringName name  = "";
 	String path;
 	void *ptr;
+	int id = 0;
+
+	//the Lifecycle callbacks the class declares itself, one bit each
+	unsigned declared_callbacks = 0;
 
 	template <typename T>
 	bool is_of_type() const
@@ -41,6 +69,10 @@ public:
 		type.name = T::get_type_name_static();
 		type.path = T::get_type_path_static();
 		type.ptr = T::get_type_ptr_static();
+		type.id = T::get_type_id_static();
+		type.declared_callbacks = get_declared_callbacks<T>();
+
+		add_ancestors(type.id, type.path);
 
 		object_types[type.name] = type;
 		types[type.name] = type.name;
@@ -56,15 +88,31 @@ public:
 
 	bool type_exists(const StringName &name) const;
 
+	//dense ids, the builtin types have the ids of their Variant::Type. Names that are
+	//not registered get an id too, so types compare by id like they compared by name
+	int get_type_id(const StringName &name);
+	StringName get_type_name(int p_id);
+
+	//whether p_ancestor is p_id or in its type path, set up when the type is registered
+	bool derives_from(int p_id, int p_ancestor) const;
+
 	//get singleton
 	static TypeManager* get_singleton();
 	static void init();
 
-	Dictionary<StringName, VariantType> types;
-	Dictionary<StringName, ObjectType> object_types;
-	Dictionary<void*, StringName> names;
+	HashMap<StringName, VariantType> types;
+	HashMap<StringName, ObjectType> object_types;
+	HashMap<void*, StringName> names;
 
 private:
+	void add_ancestors(int p_id, const String &p_path);
+
+	HashMap<StringName, int> type_ids;
+	Array<StringName> type_names;
+	std::mutex id_mutex;
+
+	//only written while the types are registered, read without a lock after that
+	Array<TypeSet> ancestors;
 
 	static TypeManager *singleton;
 };
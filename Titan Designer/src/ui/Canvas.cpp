@@ -2,6 +2,7 @@
 
 #include "input/Input.h"
 #include "input/Event.h"
+#include "input/EventManager.h"
 #include "graphics/Renderer.h"
 #include "Dialog.h"
 #include "ContextMenu.h"
@@ -195,7 +196,7 @@ void Canvas::handle_event(Event *e)
 		{
 			if (focused)
 			{
-				UIEvent *hover_event = new UIEvent(UIEvent::MOUSE_HOVER);
+				UIEvent *hover_event = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_HOVER);
 				hover_event->pos = in->pos;
 				focused->handle_event(hover_event);
 			}
@@ -205,10 +206,10 @@ void Canvas::handle_event(Event *e)
 			if (last_hover != hover)
 			{
 				if (last_hover)
-					last_hover->handle_event(new UIEvent(UIEvent::MOUSE_EXIT));
+					last_hover->handle_event(EventManager::get_manager().create_ui_event(UIEvent::MOUSE_EXIT));
 
 				if (hover)
-					hover->handle_event(new UIEvent(UIEvent::MOUSE_ENTER));
+					hover->handle_event(EventManager::get_manager().create_ui_event(UIEvent::MOUSE_ENTER));
 
 				if (hover && !hover->is_of_type<ContextTip>())
 				{
@@ -221,7 +222,7 @@ void Canvas::handle_event(Event *e)
 			}
 			else if (hover)
 			{
-				UIEvent *hover_event = new UIEvent(UIEvent::MOUSE_HOVER);
+				UIEvent *hover_event = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_HOVER);
 				hover_event->pos = in->pos;
 				hover->handle_event(hover_event);
 			}
@@ -237,7 +238,7 @@ void Canvas::handle_event(Event *e)
 			focus(hover);
 		}
 		
-		UIEvent *click = new UIEvent(UIEvent::MOUSE_PRESS);
+		UIEvent *click = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_PRESS);
 		click->pos = in->pos;
 		click->press_type = in->press_type;
 		click->button_type = in->button_type;
@@ -246,7 +247,7 @@ void Canvas::handle_event(Event *e)
 		{
 			if (hover == last_clicked && TIME->get_absolutetime() < click_time + double_click_treshold)
 			{
-				UIEvent *double_click = new UIEvent(UIEvent::MOUSE_DOUBLE_CLICK);
+				UIEvent *double_click = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_DOUBLE_CLICK);
 				click->pos = in->pos;
 
 				if (hover)
@@ -264,7 +265,7 @@ void Canvas::handle_event(Event *e)
 	}
 	else if (in->type == InputEvent::MOUSE_SCROLL)
 	{
-		UIEvent *scroll = new UIEvent(UIEvent::MOUSE_SCROLL);
+		UIEvent *scroll = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_SCROLL);
 		scroll->scroll_type = in->scroll_type;
 
 		if (hover)
@@ -272,7 +273,7 @@ void Canvas::handle_event(Event *e)
 	}
 	else if (in->type == InputEvent::KEYPRESS)
 	{
-		UIEvent *press = new UIEvent(UIEvent::KEY_PRESS);
+		UIEvent *press = EventManager::get_manager().create_ui_event(UIEvent::KEY_PRESS);
 		press->key = in->key;
 		press->press_type = in->press_type;
 		press->mod = in->mod;
@@ -282,7 +283,7 @@ void Canvas::handle_event(Event *e)
 	}
 	else if (in->type == InputEvent::TEXT_INPUT)
 	{
-		UIEvent *press = new UIEvent(UIEvent::TEXT_INPUT);
+		UIEvent *press = EventManager::get_manager().create_ui_event(UIEvent::TEXT_INPUT);
 		press->text = in->text;
 
 		if (focused)
@@ -358,8 +359,8 @@ void Canvas::focus(Control *ctrl)
 	if (ctrl == focused)
 		return;
 
-	UIEvent *win = new UIEvent(UIEvent::FOCUS_START);
-	UIEvent *lose = new UIEvent(UIEvent::FOCUS_LOSE);
+	UIEvent *win = EventManager::get_manager().create_ui_event(UIEvent::FOCUS_START);
+	UIEvent *lose = EventManager::get_manager().create_ui_event(UIEvent::FOCUS_LOSE);
 
 	if (focused)
 	{
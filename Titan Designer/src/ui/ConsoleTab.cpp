@@ -1,6 +1,7 @@
 #include "ConsoleTab.h"
 
 #include "Dock.h"
+#include "core/titanscript/ScriptProfiler.h"
 
 ConsoleTab::ConsoleTab()
 {
@@ -32,10 +33,32 @@ void ConsoleTab::handle_event(UIEvent *ui_event)
 
 void ConsoleTab::log(int p_index)
 {
-	TMessage* msg = ERROR_HANDLER->get_message(p_index);
+	TMessage msg = ERROR_HANDLER->get_message(p_index);
 
-	//if (msg->type != TMessage::T_WARNING)
-	textbox->push_back_line(ERROR_HANDLER->get_message(p_index)->description);
+	if (msg.type == TMessage::UNDEF)
+		return;
+
+	//if (msg.type != TMessage::T_WARNING)
+	textbox->push_back_line(msg.description);
+
+	textbox->set_caret_bottom();
+}
+
+void ConsoleTab::toggle_profiler()
+{
+	if (!PROFILER->is_running())
+	{
+		PROFILER->clear();
+		PROFILER->start();
+		return;
+	}
+
+	PROFILER->stop();
+
+	Array<String> report = PROFILER->get_report();
+
+	for (int c = 0; c < report.size(); c++)
+		textbox->push_back_line(report[c]);
 
 	textbox->set_caret_bottom();
 }
@@ -46,4 +69,5 @@ void ConsoleTab::log(int p_index)
 void ConsoleTab::bind_methods()
 {
 	REG_METHOD(log);
+	REG_METHOD(toggle_profiler);
 }
\ No newline at end of file
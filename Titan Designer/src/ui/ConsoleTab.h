@@ -17,6 +17,9 @@ public:
 
 	void log(int p_index);
 
+	//starts the script profiler, or stops it and prints what it sampled
+	void toggle_profiler();
+
 	static void bind_methods();
 
 private:
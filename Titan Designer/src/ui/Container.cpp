@@ -141,12 +141,14 @@ void Container::add_child(Control *p_child)
 
 void Container::remove_child(Control *_child)
 {
+	unindex_child(_child);
 	children.clean(_child);
 }
 
 void Container::clean()
 {
 	children.clean();
+	clear_child_index();
 }
 
 int Container::get_child_count() const
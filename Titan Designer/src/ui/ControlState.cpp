@@ -3,6 +3,8 @@
 #include "Control.h"
 #include "Container.h"
 
+#include "input/EventManager.h"
+
 ControlState::ControlState(Control *p_parent)
 {
 	parent = p_parent;
@@ -58,8 +60,7 @@ void ControlState::handle_event(InputEvent *input_event)
 				return;
 			else
 			{
-				key_press_event = new UIEvent;
-				key_press_event->type = UIEvent::KEY_PRESS;
+				key_press_event = EventManager::get_manager().create_ui_event(UIEvent::KEY_PRESS);
 				key_press_event->key = input_event->key;
 				key_press_event->mod = input_event->mod;
 				key_press_event->press_type = input_event->press_type;
@@ -73,8 +74,7 @@ void ControlState::handle_event(InputEvent *input_event)
 			if (!focused)
 				return;
 
-			key_press_event = new UIEvent;
-			key_press_event->type = UIEvent::TEXT_INPUT;
+			key_press_event = EventManager::get_manager().create_ui_event(UIEvent::TEXT_INPUT);
 			key_press_event->text = input_event->text;
 			key_press_event->mod = input_event->mod;
 
@@ -85,34 +85,30 @@ void ControlState::handle_event(InputEvent *input_event)
 
 void ControlState::pass_mouse_hover(const vec2 &pos)
 {
-	UIEvent *e = new UIEvent;
-	e->type = UIEvent::MOUSE_HOVER;
+	UIEvent *e = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_HOVER);
 	e->pos = pos;
 	parent->handle_event(e);
 }
 void ControlState::pass_mouse_scroll(const InputEvent::ScrollType &st)
 {
-	UIEvent *e = new UIEvent(UIEvent::MOUSE_SCROLL);
+	UIEvent *e = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_SCROLL);
 	e->scroll_type = st;
 	parent->handle_event(e);
 }
 void ControlState::pass_mouse_enter()
 {
-	UIEvent *e = new UIEvent;
-	e->type = UIEvent::MOUSE_ENTER;
+	UIEvent *e = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_ENTER);
 	parent->handle_event(e);
 }
 void ControlState::pass_mouse_exit()
 {
-	UIEvent *e = new UIEvent;
-	e->type = UIEvent::MOUSE_EXIT;
+	UIEvent *e = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_EXIT);
 	parent->handle_event(e);
 }
 
 void ControlState::pass_mouse_press(const vec2 &pos, Event::PressType press_type)
 {
-	UIEvent *e = new UIEvent;
-	e->type = UIEvent::MOUSE_PRESS;
+	UIEvent *e = EventManager::get_manager().create_ui_event(UIEvent::MOUSE_PRESS);
 	e->press_type = press_type;
 	e->pos = pos;
 	parent->handle_event(e);
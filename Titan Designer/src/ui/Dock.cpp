@@ -2,8 +2,6 @@
 
 #include "PropertyTab.h"
 
-#include "core/Memory.h"
-
 #include "Canvas.h"
 
 //=========================================================================
@@ -186,8 +184,6 @@ void Dock::remove_tab(int p_index)
 {
 	set_active_tab(0);
 
-	GC->queue_clean(tabs[p_index]);
-
 	tabs.clear(p_index);
 	selectors.clear(p_index);
 
@@ -6,9 +6,14 @@
 #include "world/Terrain.h"
 
 #include "core/CoreNames.h"
+#include "core/ThreadPool.h"
+#include "core/titanscript/TitanScript.h"
+#include "core/titanscript/CommandBuffer.h"
 
 World::World()
 {
+	parallel_update = false;
+
 	AddLayer(new Layer(0, "DefaultLayer"));
 }
 
@@ -107,23 +112,116 @@ void World::RepositionLayer(Layer *l)
 void World::handle_event(Event *e)
 {
 	for (Node* p : children)
-		p->cast_to_type<WorldObject*>()->handle_event(e);
+	{
+		WorldObject *wo = p->cast_to_type<WorldObject*>();
+
+		if (wo->implements(LIFECYCLE_HANDLE_EVENT))
+			wo->handle_event(e);
+	}
 }
 
 void World::init()
 {
-	if (has_script())
-		run(CORE_NAMES->ready, Arguments());
+	run_callback(LIFECYCLE_READY, Arguments());
 }
 
+//objects without a native or script update are skipped
 void World::update()
 {
-	if (has_script())
-		run(CORE_NAMES->update, Arguments());
+	run_callback(LIFECYCLE_UPDATE, Arguments());
+
+	if (parallel_update)
+		update_parallel();
+	else
+	{
+		for (Layer *l : layers)
+			for (WorldObject *wo : l->objects)
+				if (wo->implements(LIFECYCLE_UPDATE))
+					wo->notificate(WorldObject::NOTIFICATION_UPDATE);
+	}
+
+	free_queued();
+}
+
+void World::update_parallel()
+{
+	Array<WorldObject*> batch;
+	Dictionary<VirtualMachine*, int> runs;
+
+	for (Layer *l : layers)
+	{
+		for (WorldObject *wo : l->objects)
+		{
+			TitanScript *script = wo->get_script();
+
+			if (!script || !script->can_run_parallel(CORE_NAMES->update))
+				continue;
+
+			runs[script->get_virtual_machine()]++;
+			batch.push_back(wo);
+		}
+	}
+
+	//instances of a script share the VirtualMachine and its State, their globals are written after the batch
+	for (WorldObject *wo : batch)
+		wo->get_script()->get_virtual_machine()->set_shared(runs[wo->get_script()->get_virtual_machine()] > 1);
+
+	while (command_buffers.size() < THREADPOOL->get_worker_count())
+		command_buffers.push_back(new CommandBuffer);
+
+	THREADPOOL->run_batch(batch.size(), [&](int p_task, int p_worker)
+	{
+		CommandBuffer *buffer = command_buffers[p_worker];
+		buffer->task = p_task;
+
+		CommandBuffer::current = buffer;
+		batch[p_task]->run(CORE_NAMES->update, Arguments());
+		CommandBuffer::current = NULL;
+	});
+
+	for (WorldObject *wo : batch)
+		wo->get_script()->get_virtual_machine()->set_shared(false);
+
+	CommandBuffer::apply(command_buffers);
+
+	//native updates and the remaining scripts run in order on this thread
+	int next = 0;
 
 	for (Layer *l : layers)
+	{
 		for (WorldObject *wo : l->objects)
-			wo->notificate(WorldObject::NOTIFICATION_UPDATE);
+		{
+			if (next < batch.size() && batch[next] == wo)
+			{
+				wo->update();
+				next++;
+			}
+			else if (wo->implements(LIFECYCLE_UPDATE))
+				wo->notificate(WorldObject::NOTIFICATION_UPDATE);
+		}
+	}
+}
+
+void World::queue_free(WorldObject *p_object)
+{
+	//scripts in a parallel update free objects from the workers
+	std::lock_guard<std::mutex> lock(free_mutex);
+
+	if (!free_queue.contains(p_object))
+		free_queue.push_back(p_object);
+}
+
+void World::free_queued()
+{
+	Array<WorldObject*> queued;
+	{
+		std::lock_guard<std::mutex> lock(free_mutex);
+		std::swap(queued, free_queue);
+	}
+
+	//the destructor removes the object from this world and its layer
+	for (WorldObject *wo : queued)
+		delete wo;
 }
 
 void World::draw()
@@ -138,6 +236,7 @@ void World::draw()
 void World::Free()
 {
 	children.clean();
+	clear_child_index();
 }
 
 void World::set_active_camera(Camera *p_camera)
@@ -150,6 +249,16 @@ Camera* World::get_active_camera() const
 	return active_camera;
 }
 
+void World::set_parallel_update(bool p_parallel_update)
+{
+	parallel_update = p_parallel_update;
+}
+
+bool World::get_parallel_update() const
+{
+	return parallel_update;
+}
+
 PhysicsWorld2D* World::get_physics_2d() const
 {
 	return nullptr;
@@ -168,4 +277,6 @@ void World::bind_methods()
 	REG_CSTR(0);
 
 	REG_METHOD(get_viewport);
+
+	REG_PROPERTY(parallel_update);
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <mutex>
+
 #include "WorldObject.h"
 #include "ui/Layer.h"
 #include "Camera.h"
 #include "core/Node.h"
 
 class Viewport;
+class CommandBuffer;
 class PhysicsWorld2D;
 class PhysicsWorld3D;
 
@@ -42,13 +45,29 @@ public:
 	PhysicsWorld2D* get_physics_2d() const;
 	PhysicsWorld3D* get_physics_3d() const;
 
+	//runs the update of objects with a local script on the ThreadPool
+	void set_parallel_update(bool p_parallel_update);
+	bool get_parallel_update() const;
+
+	//deletes p_object at the end of the update, when no script runs on it anymore
+	void queue_free(WorldObject *p_object);
+
 	Vector<Layer> layers;
 
 	static void bind_methods();
 
 private:
+	void update_parallel();
+	void free_queued();
+
 	Camera *active_camera;
 	PhysicsWorld2D* physics_2d;
 	PhysicsWorld2D* physics_3d;
+
+	bool parallel_update;
+	Array<CommandBuffer*> command_buffers;
+
+	std::mutex free_mutex;
+	Array<WorldObject*> free_queue;
 };
 
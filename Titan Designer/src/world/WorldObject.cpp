@@ -28,47 +28,20 @@ WorldObject::~WorldObject()
 
 void WorldObject::handle_event(Event *e)
 {
-	if (method_exists(CORE_NAMES->handle_event))
-	{
-		run(CORE_NAMES->handle_event, Arguments(e));
-		return;
-	}
+	run_callback(LIFECYCLE_HANDLE_EVENT, Arguments(e));
 }
 
 void WorldObject::notificate(int notification)
 {
-	if (has_script())
-	{
-		StringName sname;
-
-		switch (notification)
-		{
-		case NOTIFICATION_READY:
-			sname = CORE_NAMES->ready;
-			break;
-
-		case NOTIFICATION_DRAW:
-			sname = CORE_NAMES->draw;
-			break;
-
-		case NOTIFICATION_UPDATE:
-			sname = CORE_NAMES->update;
-			break;
-		}
-
-		if (method_exists(sname))
-		{
-			run(sname, Arguments());
-		}
-	}
-
 	switch (notification)
 	{
 	case NOTIFICATION_READY:
+		run_callback(LIFECYCLE_READY, Arguments());
 		ready();
 		break;
 
 	case NOTIFICATION_DRAW:
+		run_callback(LIFECYCLE_DRAW, Arguments());
 		draw();
 		break;
 
@@ -77,6 +50,7 @@ void WorldObject::notificate(int notification)
 		break;
 
 	case NOTIFICATION_UPDATE:
+		run_callback(LIFECYCLE_UPDATE, Arguments());
 		update();
 		break;
 	}
@@ -252,7 +226,11 @@ void WorldObject::register_in_world(World *p_world)
 
 void WorldObject::free()
 {
-	GC->queue_free(this);
+	//the script that calls this still runs on the object
+	if (world)
+		world->queue_free(this);
+	else
+		delete this;
 }
 
 template<typename T> T WorldObject::GetComponent()